@@ -103,8 +103,12 @@ _LVOCacheControl        EQU     -648
 
         ; Executable file image information
         ; length / start (sector aligned, shifted right by 8)
+        ; unpacked length (as above, zero if executable is not compressed)
+        ;
+        ; If executable file image is compressed, length / start describe
+        ; decompressing loader that precedes the compressed image on disk.
 ExecInfo:
-        dc.w    0, 0
+        dc.w    0, 0, 0
 
 ; AmigaOS loads boot block somewhere at the beginning of chip memory and 
 ; jumps in here.
@@ -118,9 +122,10 @@ ExecInfo:
 Entry:
         move.l  a1,-(sp)                ; trackdisk.device IORequest
 
-        movem.w ExecInfo(pc),d2/d4
+        movem.w ExecInfo(pc),d2/d4-d5
         lsl.l   #8,d2                   ; [d2] executable length in bytes
         lsl.l   #8,d4                   ; [d4] executable start in bytes
+        lsl.l   #8,d5                   ; [d5] unpacked length in bytes
 
         ; allocate memory for executable file
         move.l  d2,d0
@@ -133,6 +138,16 @@ Entry:
         movem.l d2-d4,IO_LENGTH(a1)     ; length / data / start 
         JSRLIB  DoIO
 
+        ; if executable file is compressed then we've just read decompressing
+        ; loader, which reads the rest track by track and unpacks it
+        tst.l   d5
+        beq.b   .unpacked
+        move.l  d3,a0
+        add.l   d2,d4                   ; [d4] compressed image start
+        move.l  d5,d2                   ; [d2] unpacked length in bytes
+        jsr     (a0)                    ; [d3] unpacked executable file image
+.unpacked
+
         ; turn off the motor
         clr.l   IO_LENGTH(a1)
         move.w  #TD_MOTOR,IO_COMMAND(a1)
@@ -34,6 +34,60 @@ FRAMES_PER_ROW ?= 6
 
 CPPFLAGS += -DUAE
 
+# Pass "PROFILER=0" to remove profiling scopes (see include/effect.h).
+PROFILER ?= 1
+ifeq ($(PROFILER), 1)
+CONFIG-FLAGS += -DPROFILER
+endif
+
+# Pass "RASTERBARS=1" to show profiling scopes as background color changes.
+ifeq ($(RASTERBARS), 1)
+CONFIG-FLAGS += -DRASTERBARS
+endif
+
+# Pass "SAMPLER=<rate>" to run statistical profiler (see system/sampler.h).
+ifneq ($(SAMPLER),)
+CONFIG-FLAGS += -DSAMPLER=$(SAMPLER)
+endif
+
+# Pass "BLITSTATS=1" to gather blitter utilisation counters (see
+# include/system/blitstats.h).
+ifeq ($(BLITSTATS), 1)
+CONFIG-FLAGS += -DBLITSTATS
+endif
+
+# Pass "LOGBIN=1" to record log messages in binary form and decode them on
+# the host with tools/logdecode (see include/system/debug.h).
+ifeq ($(LOGBIN), 1)
+CONFIG-FLAGS += -DLOGBIN
+endif
+
+# Pass "RECORD=1" to log frame timing and input events, and "REPLAY=<log>"
+# to play them back deterministically (see include/system/replay.h).
+ifeq ($(RECORD), 1)
+CONFIG-FLAGS += -DRECORD
+endif
+
+ifneq ($(REPLAY),)
+CONFIG-FLAGS += -DREPLAY
+endif
+
+# Pass "BENCH=<frames>" to stop each effect after given number of frames and
+# quit the emulator afterwards (used by "make bench" in effects directory).
+ifneq ($(BENCH),)
+CONFIG-FLAGS += -DBENCH=$(BENCH)
+endif
+
+CPPFLAGS += $(CONFIG-FLAGS)
+
+# Remember build configuration, so that objects get rebuilt when it changes.
+# The file is (re)written if it's missing too, as objects depend on it.
+CONFIG := $(TOPDIR)/.config
+ifneq ($(shell cat $(CONFIG) 2>/dev/null || echo '<missing>'), \
+       $(strip $(CONFIG-FLAGS)))
+$(shell echo '$(strip $(CONFIG-FLAGS))' > $(CONFIG))
+endif
+
 # Pass "VERBOSE=1" at command line to display command being invoked by GNU Make
 ifneq ($(VERBOSE), 1)
 .SILENT:
@@ -49,6 +103,9 @@ ROMUTIL := $(TOPDIR)/tools/romutil.py
 FSUTIL := $(TOPDIR)/tools/fsutil.py
 BINPATCH := $(TOPDIR)/tools/binpatch.py
 LAUNCH := $(PYTHON3) $(TOPDIR)/tools/launch.py
+BENCHRUN := $(TOPDIR)/tools/bench.py
+CAPTURE := $(PYTHON3) $(TOPDIR)/tools/capture.py
+REPLAYCONV := $(TOPDIR)/tools/replay.py
 LWO2C := $(TOPDIR)/tools/lwo2c.py $(QUIET)
 CONV2D := $(TOPDIR)/tools/conv2d.py
 GRADIENT := $(TOPDIR)/tools/gradient.py
@@ -66,6 +123,8 @@ SOURCES_S = $(filter %.S,$(SOURCES))
 SOURCES_ASM = $(filter %.asm,$(SOURCES))
 OBJECTS += $(SOURCES_C:%.c=%.o) $(SOURCES_S:%.S=%.o) $(SOURCES_ASM:%.asm=%.o)
 
+$(OBJECTS): $(CONFIG)
+
 DEPENDENCY-FILES += $(foreach f, $(SOURCES_C),\
 		      $(dir $(f))$(patsubst %.c,.%.D,$(notdir $(f))))
 DEPENDENCY-FILES += $(foreach f, $(SOURCES_S),\
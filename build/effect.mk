@@ -5,15 +5,28 @@ SOURCES = $(EFFECT).c
 endif
 
 LIBS += libblit libgfx libmisc libc
-LDEXTRA = $(TOPDIR)/system/system.a
-LDEXTRA += $(foreach lib,$(LIBS),$(TOPDIR)/lib/$(lib)/$(lib).a)
+LDLIBS = $(foreach lib,$(LIBS),$(TOPDIR)/lib/$(lib)/$(lib).a)
+LDEXTRA = $(TOPDIR)/system/system.a $(LDLIBS)
+# Parts reach the kernel only through system calls and shared variables.
+# Their addresses come from an object generated from system/system-api.in.
+LDPART = $(TOPDIR)/system/syscall.o $(LDLIBS)
 
 CRT0 = $(TOPDIR)/system/crt0.o
+CRT0PART = $(TOPDIR)/system/crt0-part.o
 BOOTLOADER = $(TOPDIR)/bootloader.bin
+BOOTINFLATE = $(TOPDIR)/bootinflate.bin
 ROMSTARTUP = $(TOPDIR)/a500rom.bin
 
 EXTRA-FILES += $(DATA_GEN) $(EFFECT).img $(EFFECT).adf $(EFFECT).rom
 CLEAN-FILES += $(DATA_GEN) $(EFFECT).exe $(EFFECT).exe.dbg $(EFFECT).exe.map 
+CLEAN-FILES += $(EFFECT).part $(EFFECT).part.dbg $(EFFECT).part.map
+CLEAN-FILES += capture-*.png
+
+# Replay data is linked into the effect (see include/system/replay.h).
+ifneq ($(REPLAY),)
+OBJECTS += replay.o
+CLEAN-FILES += replay.c
+endif
 
 all: build
 
@@ -30,6 +43,9 @@ $(TOPDIR)/system/%.a: FORCE
 $(TOPDIR)/effects/%.a: FORCE
 	$(MAKE) -C $(dir $@) $(notdir $@)
 
+$(TOPDIR)/effects/%.part: FORCE
+	$(MAKE) -C $(dir $@) $(notdir $@)
+
 $(TOPDIR)/%.bin: FORCE
 	$(MAKE) -C $(dir $@) $(notdir $@)
 
@@ -42,6 +58,16 @@ $(EFFECT).exe.dbg $(EFFECT).exe: $(CRT0) $(OBJECTS) $(LDEXTRA) $(LDSCRIPT)
 	$(CP) $@ $@.dbg
 	$(STRIP) $@
 
+# Effect linked as a part of trackmo (see include/system/part.h). It doesn't
+# contain any kernel code, but it refers to system calls and shared variables
+# at fixed addresses, and carries its own copies of libraries.
+$(EFFECT).part.dbg $(EFFECT).part: $(CRT0PART) $(OBJECTS) $(LDPART) $(LDSCRIPT)
+	@echo "[LD] $(addprefix $(DIR),$(OBJECTS)) -> $(DIR)$@"
+	$(LD) $(LDFLAGS) -L$(TOPDIR)/system -T$(LDSCRIPT) -Map=$@.map -o $@ \
+		--start-group $(filter-out %.lds,$^) --end-group
+	$(CP) $@ $@.dbg
+	$(STRIP) $@
+
 data/%.c: data/%.lwo
 	@echo "[LWO] $(DIR)$< -> $(DIR)$@"
 	$(LWO2C) $(LWO2C.$*) -f $< $@
@@ -66,14 +92,18 @@ data/%.c: data/%.sync
 	@echo "[IMG] $(addprefix $(DIR),$*.exe $(DATA) $(DATA_GEN)) -> $(DIR)$@"
 	$(FSUTIL) create $@ $(filter-out %bootloader.bin,$^)
 
-%.adf: %.img $(BOOTLOADER) 
+%.adf: %.img $(BOOTLOADER) $(BOOTINFLATE)
 	@echo "[ADF] $(DIR)$< -> $(DIR)$@"
-	$(ADFUTIL) -b $(BOOTLOADER) $< $@ 
+	$(ADFUTIL) -b $(BOOTLOADER) -i $(BOOTINFLATE) $< $@
 
 %.rom: %.img $(ROMSTARTUP)
 	@echo "[ROM] $(DIR)$< -> $(DIR)$@"
 	$(ROMUTIL) $(ROMSTARTUP) $< $@ 
 
+replay.c: $(REPLAY)
+	@echo "[REPLAY] $(DIR)$< -> $(DIR)$@"
+	$(REPLAYCONV) $< > $@ || (rm -f $@ && exit 1)
+
 # Default debugger - can be changed by passing DEBUGGER=xyz to make.
 DEBUGGER ?= gdb
 
@@ -89,5 +119,16 @@ run: $(EFFECT).rom $(EFFECT).exe.dbg $(EFFECT).adf
 debug: $(EFFECT).rom $(EFFECT).exe.dbg $(EFFECT).adf
 	$(LAUNCH) -d $(DEBUGGER) -r $(EFFECT).rom -e $(EFFECT).exe.dbg -f $(EFFECT).adf
 
-.PHONY: run debug run-floppy debug-floppy
-.PRECIOUS: $(BOOTLOADER) $(EFFECT).img
+# Render frame displayed at given frame number to PNG file and compare it
+# with golden image. Use "make capture-golden" to accept new image.
+FRAME ?= 100
+
+capture: $(EFFECT).rom $(EFFECT).adf
+	$(CAPTURE) -r $(EFFECT).rom -f $(EFFECT).adf -n $(FRAME) \
+	  -g golden-$(FRAME).png capture-$(FRAME).png
+
+capture-golden: $(EFFECT).rom $(EFFECT).adf
+	$(CAPTURE) -r $(EFFECT).rom -f $(EFFECT).adf -n $(FRAME) golden-$(FRAME).png
+
+.PHONY: run debug run-floppy debug-floppy capture capture-golden
+.PRECIOUS: $(BOOTLOADER) $(BOOTINFLATE) $(EFFECT).img
@@ -1,5 +1,6 @@
 #include <effect.h>
 #include <blitter.h>
+#include <c2p.h>
 #include <copper.h>
 #include <fx.h>
 #include <pixmap.h>
@@ -15,6 +16,7 @@
 
 static PixmapT *textureHi, *textureLo;
 static PixmapT *chunky;
+static C2PT c2p;
 static BitmapT *bitmap;
 static SprDataT *sprdat;
 static SpriteT sprite[2][8];
@@ -97,6 +99,10 @@ static void Init(void) {
   bitmap = NewBitmap(WIDTH, HEIGHT, S_DEPTH);
   chunky = NewPixmap(WIDTH, HEIGHT, PM_CMAP4, MEMF_CHIP);
 
+  /* Bitplanes are used as scratch buffer, as they're overwritten anyway. */
+  C2PSetup(&c2p, C2P_1X1_4BPL_SCRAMBLED, WIDTH, HEIGHT,
+           chunky->pixels, bitmap->planes[0], bitmap->planes);
+
   UVMapRender = MemAlloc(UVMapRenderSize, MEMF_PUBLIC);
   MakeUVMapRenderCode();
 
@@ -147,127 +153,6 @@ static void Kill(void) {
   DeleteBitmap(bitmap);
 }
 
-#define BLTSIZE (WIDTH * HEIGHT / 2)
-
-#if (BLTSIZE / 4) > 1024
-#error "blit size too big!"
-#endif
-
-static void ChunkyToPlanar(PixmapT *input, BitmapT *output) {
-  void *planes = output->planes[0];
-  void *chunky = input->pixels;
-
-  /* Swap 8x4, pass 1. */
-  {
-    WaitBlitter();
-
-    /* (a & 0xFF00) | ((b >> 8) & ~0xFF00) */
-    custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-    custom->bltcon1 = BSHIFT(8);
-    custom->bltafwm = -1;
-    custom->bltalwm = -1;
-    custom->bltamod = 4;
-    custom->bltbmod = 4;
-    custom->bltdmod = 4;
-    custom->bltcdat = 0xFF00;
-
-    custom->bltapt = chunky;
-    custom->bltbpt = chunky + 4;
-    custom->bltdpt = planes;
-    custom->bltsize = 2 | ((BLTSIZE / 8) << 6);
-  }
-
-  /* Swap 8x4, pass 2. */
-  {
-    WaitBlitter();
-
-    /* ((a << 8) & 0xFF00) | (b & ~0xFF00) */
-    custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(8);
-    custom->bltcon1 = BLITREVERSE;
-
-    custom->bltapt = chunky + BLTSIZE - 6;
-    custom->bltbpt = chunky + BLTSIZE - 2;
-    custom->bltdpt = planes + BLTSIZE - 2;
-    custom->bltsize = 2 | ((BLTSIZE / 8) << 6);
-  }
-
-  /* Swap 4x2, pass 1. */
-  {
-    WaitBlitter();
-
-    /* (a & 0xF0F0) | ((b >> 4) & ~0xF0F0) */
-    custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-    custom->bltcon1 = BSHIFT(4);
-    custom->bltamod = 2;
-    custom->bltbmod = 2;
-    custom->bltdmod = 2;
-    custom->bltcdat = 0xF0F0;
-
-    custom->bltapt = planes;
-    custom->bltbpt = planes + 2;
-    custom->bltdpt = chunky;
-    custom->bltsize = 1 | ((BLTSIZE / 4) << 6);
-  }
-
-  /* Swap 4x2, pass 2. */
-  {
-    WaitBlitter();
-
-    /* ((a << 4) & 0xF0F0) | (b & ~0xF0F0) */
-    custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(4);
-    custom->bltcon1 = BLITREVERSE;
-
-    custom->bltapt = planes + BLTSIZE - 4;
-    custom->bltbpt = planes + BLTSIZE - 2;
-    custom->bltdpt = chunky + BLTSIZE - 2;
-    custom->bltsize = 1 | ((BLTSIZE / 4) << 6);
-  }
-
-  /* Swap 2x1, pass 1 & 2. */
-  {
-    WaitBlitter();
-
-    /* (a & 0xCCCC) | ((b >> 2) & ~0xCCCC) */
-    custom->bltamod = 6;
-    custom->bltbmod = 6;
-    custom->bltdmod = 0;
-    custom->bltcdat = 0xCCCC;
-    custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-    custom->bltcon1 = BSHIFT(2);
-
-    custom->bltapt = chunky;
-    custom->bltbpt = chunky + 4;
-    custom->bltdpt = planes + BLTSIZE * 3 / 4;
-    custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-
-    WaitBlitter();
-    custom->bltapt = chunky + 2;
-    custom->bltbpt = chunky + 6;
-    custom->bltdpt = planes + BLTSIZE * 2 / 4;
-    custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-  }
-
-  /* Swap 2x1, pass 3 & 4. */
-  {
-    WaitBlitter();
-
-    /* ((a << 2) & 0xCCCC) | (b & ~0xCCCC) */
-    custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(2);
-    custom->bltcon1 = BLITREVERSE;
-
-    custom->bltapt = chunky + BLTSIZE - 8;
-    custom->bltbpt = chunky + BLTSIZE - 4;
-    custom->bltdpt = planes + BLTSIZE * 2 / 4 - 2;
-    custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-
-    WaitBlitter();
-    custom->bltapt = chunky + BLTSIZE - 6;
-    custom->bltbpt = chunky + BLTSIZE - 2;
-    custom->bltdpt = planes + BLTSIZE * 1 / 4 - 2;
-    custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-  }
-}
-
 static void BitmapToSprite(BitmapT *input, SpriteT sprite[8]) {
   void *planes = input->planes[0];
   short bltsize = (input->height << 6) | 1;
@@ -337,7 +222,7 @@ static void Render(void) {
   ProfilerStart(UVMapRender);
   {
     (*UVMapRender)(chunky->pixels, txtHi, txtLo);
-    ChunkyToPlanar(chunky, bitmap);
+    C2PRun(&c2p);
     BitmapToSprite(bitmap, sprite[active]);
     PositionSprite(sprite[active], xo / 2, yo / 2);
   }
@@ -69,7 +69,7 @@ static void Init(void) {
   }
 
   buffer = NewBitmap(SIZE, SIZE, 4);
-  carry = NewBitmap(SIZE, SIZE, 2);
+  carry = NewBitmap(SIZE, SIZE, 1);
 
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(0), WIDTH, HEIGHT);
 
@@ -123,9 +123,9 @@ static void Render(void) {
   ProfilerStart(BlurredRender);
   {
     if (iterCount++ & 1)
-      BitmapDecSaturated(buffer, carry);
+      BitmapDecSaturated(buffer, buffer, carry);
     DrawShape();
-    BitmapIncSaturated(buffer, carry);
+    BitmapIncSaturated(buffer, buffer, carry);
     BitmapCopy(screen[active], 16, 0, buffer);
   }
   ProfilerStop(BlurredRender);
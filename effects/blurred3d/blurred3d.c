@@ -70,7 +70,7 @@ static void Init(void) {
 
   screen0 = NewBitmap(WIDTH, HEIGHT + 1, DEPTH);
   screen1 = NewBitmap(WIDTH, HEIGHT + 1, DEPTH);
-  carry = NewBitmap(WIDTH, HEIGHT, 2);
+  carry = NewBitmap(WIDTH, HEIGHT + 1, 1);
   scratchpad = NewBitmap(WIDTH, HEIGHT, 2);
 
   EnableDMA(DMAF_BLITTER | DMAF_BLITHOG);
@@ -329,124 +329,6 @@ static void DrawObject(Object3D *object) {
   }
 }
 
-static void BitmapDecSaturatedFast(BitmapT *dstbm, BitmapT *srcbm) {
-  void *borrow0 = carry->planes[0];
-  void *borrow1 = carry->planes[1];
-  void **srcbpl = srcbm->planes;
-  void **dstbpl = dstbm->planes;
-  void *src = *srcbpl++;
-  void *dst = *dstbpl++;
-  short n = DEPTH - 1;
-
-  WaitBlitter();
-  custom->bltcon1 = 0;
-  custom->bltamod = 0;
-  custom->bltbdat = -1;
-  custom->bltbmod = 0;
-  custom->bltdmod = 0;
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
-
-  custom->bltapt = src;
-  custom->bltdpt = borrow0;
-  custom->bltcon0 = HALF_SUB_BORROW & ~SRCB;
-  custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-
-  WaitBlitter();
-  custom->bltapt = src;
-  custom->bltdpt = dst;
-  custom->bltcon0 = HALF_SUB & ~SRCB;
-  custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-
-  while (--n >= 0) {
-    src = *srcbpl++;
-    dst = *dstbpl++;
-
-    WaitBlitter();
-    custom->bltapt = src;
-    custom->bltbpt = borrow0;
-    custom->bltdpt = borrow1;
-    custom->bltcon0 = HALF_SUB_BORROW;
-    custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-
-    WaitBlitter();
-    custom->bltapt = src;
-    custom->bltbpt = borrow0;
-    custom->bltdpt = dst;
-    custom->bltcon0 = HALF_SUB;
-    custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-
-    swapr(borrow0, borrow1);
-  }
-
-  dstbpl = dstbm->planes;
-  n = DEPTH;
-
-  while (--n >= 0) {
-    dst = *dstbpl++;
-
-    WaitBlitter();
-    custom->bltapt = dst;
-    custom->bltbpt = borrow0;
-    custom->bltdpt = dst;
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_AND_NOT_B;
-    custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-  }
-}
-
-static void BitmapIncSaturatedFast(BitmapT *dstbm, BitmapT *srcbm) {
-  void *carry0 = carry->planes[0];
-  void *carry1 = carry->planes[1];
-  void **srcbpl = srcbm->planes;
-  void **dstbpl = dstbm->planes;
-  short n = DEPTH;
-
-  /* Only pixels set to one in carry[0] will be incremented. */
-  
-  WaitBlitter();
-  custom->bltcon1 = 0;
-  custom->bltamod = 0;
-  custom->bltbmod = 0;
-  custom->bltdmod = 0;
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
-
-  while (--n >= 0) {
-    void *src = *srcbpl++;
-    void *dst = *dstbpl++;
-
-    WaitBlitter();
-    custom->bltapt = src;
-    custom->bltbpt = carry0;
-    custom->bltdpt = carry1;
-    custom->bltcon0 = HALF_ADDER_CARRY;
-    custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-
-    WaitBlitter();
-    custom->bltapt = src;
-    custom->bltbpt = carry0;
-    custom->bltdpt = dst;
-    custom->bltcon0 = HALF_ADDER;
-    custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-
-    swapr(carry0, carry1);
-  }
-
-  dstbpl = dstbm->planes;
-  n = DEPTH;
-
-  while (--n >= 0) {
-    void *dst = *dstbpl++;
-
-    WaitBlitter();
-    custom->bltapt = dst;
-    custom->bltbpt = carry0;
-    custom->bltdpt = dst;
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
-    custom->bltsize = (HEIGHT << 6) | (WIDTH >> 4);
-  }
-}
-
 PROFILE(UpdateGeometry);
 PROFILE(DrawObject);
 
@@ -476,13 +358,13 @@ static void Render(void) {
   BitmapT *source = screen1;
 
   if (iterCount++ & 1) {
-    BitmapDecSaturatedFast(screen0, screen1);
+    BitmapDecSaturated(screen0, screen1, carry);
     source = screen0;
   }
 
   RenderObject3D();
 
-  BitmapIncSaturatedFast(screen0, source);
+  BitmapIncSaturated(screen0, source, carry);
 
   {
     short n = DEPTH;
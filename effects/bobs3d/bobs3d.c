@@ -1,19 +1,28 @@
 #include "effect.h"
 #include "blitter.h"
 #include "copper.h"
+#include "2d.h"
 #include "3d.h"
 #include "fx.h"
+#include "bob.h"
+#include <system/memory.h>
 
 #define WIDTH  256
 #define HEIGHT 256
 #define DEPTH 3
 
+#define BOBW 32
+#define BOBH 32
+
 #define TZ (-256)
 
 static Object3D *cube;
 static CopListT *cp;
 static BitmapT *screen0, *screen1;
 static CopInsT *bplptr[DEPTH];
+static DirtyRectsT dirty;
+static BobImageT flare;
+static BobT *bob;
 
 #include "data/flares32.c"
 #include "data/pilka.c"
@@ -36,6 +45,18 @@ static void Init(void) {
   screen1 = NewBitmapCustom(WIDTH, HEIGHT, DEPTH,
                             BM_DISPLAYABLE | BM_INTERLEAVED);
 
+  BitmapClear(screen0);
+  BitmapClear(screen1);
+  DirtyRectsInit(&dirty, 2, NULL);
+
+  ClipWin.minX = fx4i(0);
+  ClipWin.maxX = fx4i(WIDTH - 1);
+  ClipWin.minY = fx4i(0);
+  ClipWin.maxY = fx4i(HEIGHT - 1);
+
+  InitBobImage(&flare, &bobs, BOBW, BOB_OR);
+  bob = MemAlloc(sizeof(BobT) * mesh->vertices, MEMF_PUBLIC);
+
   SetupPlayfield(MODE_LORES, DEPTH, X(32), Y(0), WIDTH, HEIGHT);
   LoadPalette(&bobs_pal, 0);
 
@@ -51,6 +72,8 @@ static void Kill(void) {
   DeleteBitmap(screen0);
   DeleteBitmap(screen1);
   DeleteObject3D(cube);
+  KillBobImage(&flare);
+  MemFree(bob);
 }
 
 #define MULVERTEX1(D, E) {              \
@@ -113,77 +136,10 @@ static void TransformVertices(Object3D *object) {
   } while (--n > 0);
 }
 
-#define BOBW 32
-#define BOBH 32
-
-#define OPTIMIZED 1
-
-#if OPTIMIZED
-#define SRCROW (512 / 8)
-#define DSTROW (256 / 8)
-#else
-#define SRCROW src->bytesPerRow
-#define DSTROW dst->bytesPerRow
-#endif
-
-void BlitterOrArea(BitmapT *dst asm("a0"), u_short x asm("d0"), u_short y asm("d1"),
-                   const BitmapT *src asm("a1"), u_short sx asm("d2"))
-{
-  u_short dxo = x & 15;
-  u_short width = dxo + BOBW;
-  u_short wo = width & 15;
-  u_short bytesPerRow = ((width + 15) & ~15) >> 3;
-  u_short srcmod = SRCROW - bytesPerRow;
-  u_short dstmod = DSTROW - bytesPerRow;
-  u_short bltafwm = FirstWordMask[dxo];
-  u_short bltalwm = LastWordMask[wo];
-  u_short bltshift = rorw(dxo, 4);
-
-  u_int src_start = (sx & ~15) >> 3;
-  u_int dst_start = ((x & ~15) >> 3) + y * DSTROW * DEPTH;
-  u_short bltsize = (BOBH * DEPTH << 6) | (bytesPerRow >> 1);
-
-  void *srcbpt = src->planes[0] + src_start;
-  void *dstbpt = dst->planes[0] + dst_start;
-
-  bool fast = (dxo == 0);
-
-  WaitBlitter();
-
-  if (fast) {
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
-    custom->bltcon1 = 0;
-    custom->bltafwm = -1;
-    custom->bltalwm = -1;
-    custom->bltamod = srcmod;
-    custom->bltbmod = dstmod;
-    custom->bltdmod = dstmod;
-
-    custom->bltapt = srcbpt;
-    custom->bltbpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
-  } else {
-    /* AB + C */
-    custom->bltcon0 = (SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NABC | NANBC);
-    custom->bltcon1 = bltshift;
-    custom->bltadat = -1;
-    custom->bltafwm = bltafwm;
-    custom->bltalwm = bltalwm;
-    custom->bltbmod = srcmod;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
-
-    custom->bltbpt = srcbpt;
-    custom->bltcpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
-  }
-}
-
 static void DrawObject(Object3D *object, BitmapT *dst) {
   short *data = (short *)object->vertex;
   register short n asm("d7") = object->mesh->vertices;
+  BobT *b = bob;
 
 #if 0
   short minZ = 32767, maxZ = -32768;
@@ -207,28 +163,23 @@ static void DrawObject(Object3D *object, BitmapT *dst) {
       maxZ = z;
 #endif
 
-    BlitterOrArea(dst, x - 16, y - 16, &bobs, z);
+    b->image = &flare;
+    b->x = x - BOBW / 2;
+    b->y = y - BOBH / 2;
+    b->frame = z >> 5;
+    b++;
 
     data++;
   } while (--n > 0);
-}
-
-static void BitmapClearI(BitmapT *bm) {
-  WaitBlitter();
 
-  custom->bltadat = 0;
-  custom->bltcon0 = DEST | A_TO_D;
-  custom->bltcon1 = 0;
-  custom->bltdmod = 0;
-  custom->bltdpt = bm->planes[0];
-  custom->bltsize = ((bm->height * bm->depth) << 6) | (bm->bytesPerRow >> 1);
+  DrawBobs(dst, bob, object->mesh->vertices, &dirty);
 }
 
 PROFILE(TransformObject);
 PROFILE(DrawObject);
 
 static void Render(void) {
-  BitmapClearI(screen0);
+  DirtyRectsRestore(&dirty, screen0);
 
   ProfilerStart(TransformObject);
   {
@@ -251,6 +202,7 @@ static void Render(void) {
 
   CopUpdateBitplanes(bplptr, screen0, DEPTH);
   swapr(screen0, screen1);
+  DirtyRectsFlip(&dirty);
 }
 
 EFFECT(bobs3d, NULL, NULL, Init, Kill, Render);
@@ -1,5 +1,6 @@
 #include <effect.h>
 #include <blitter.h>
+#include <c2p.h>
 #include <color.h>
 #include <copper.h>
 #include <fx.h>
@@ -137,132 +138,18 @@ static void UnLoad(void) {
   MemFree(lightmap);
 }
 
-static struct {
-  short phase;
-  void **bpl;
-  void *chunky;
-} c2p = { 256, NULL, NULL };
-
-#define BPLSIZE ((WIDTH * 4) * HEIGHT / 8) /* 2560 bytes */
-#define BLTSIZE ((WIDTH * 4) * HEIGHT / 2) /* 10240 bytes */
+static C2PT conv[2];
+static C2PT *c2p = &conv[0];
 
 static void ChunkyToPlanar(void) {
-  void *src = c2p.chunky;
-  void *dst = c2p.chunky + BLTSIZE;
-  void **bpl = c2p.bpl;
-
-  switch (c2p.phase) {
-    case 0:
-      /* Initialize chunky to planar. */
-      custom->bltamod = 4;
-      custom->bltbmod = 4;
-      custom->bltdmod = 4;
-      custom->bltcdat = 0x00FF;
-      custom->bltafwm = -1;
-      custom->bltalwm = -1;
-
-      /* Swap 8x4, pass 1. */
-      custom->bltapt = src + 4;
-      custom->bltbpt = src;
-      custom->bltdpt = dst;
-
-      /* ((a >> 8) & 0x00FF) | (b & ~0x00FF) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ANBC | ABNC | NABNC) | ASHIFT(8);
-      custom->bltcon1 = 0;
-      custom->bltsize = 2 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 1:
-      custom->bltsize = 2 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 2:
-      /* Swap 8x4, pass 2. */
-      custom->bltapt = src + BLTSIZE - 6;
-      custom->bltbpt = src + BLTSIZE - 2;
-      custom->bltdpt = dst + BLTSIZE - 2;
-
-      /* ((a << 8) & ~0x00FF) | (b & 0x00FF) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABNC | ANBNC | ABC | NABC) | ASHIFT(8);
-      custom->bltcon1 = BLITREVERSE;
-      custom->bltsize = 2 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 3:
-      custom->bltsize = 2 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 4:
-      custom->bltamod = 6;
-      custom->bltbmod = 6;
-      custom->bltdmod = 0;
-      custom->bltcdat = 0x0F0F;
-
-      custom->bltapt = dst + 2;
-      custom->bltbpt = dst;
-      custom->bltdpt = bpl[0];
-
-      /* ((a >> 4) & 0x0F0F) | (b & ~0x0F0F) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ANBC | ABNC | NABNC) | ASHIFT(4);
-      custom->bltcon1 = 0;
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 5:
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 6:
-      custom->bltapt = dst + 6;
-      custom->bltbpt = dst + 4;
-      custom->bltdpt = bpl[2];
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 7:
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 8:
-      custom->bltapt = dst + BLTSIZE - 8;
-      custom->bltbpt = dst + BLTSIZE - 6;
-      custom->bltdpt = bpl[1] + BPLSIZE - 2;
-
-      /* ((a << 8) & ~0x0F0F) | (b & 0x0F0F) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABNC | ANBNC | ABC | NABC) | ASHIFT(4);
-      custom->bltcon1 = BLITREVERSE;
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 9:
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 10:
-      custom->bltapt = dst + BLTSIZE - 4;
-      custom->bltbpt = dst + BLTSIZE - 2;
-      custom->bltdpt = bpl[3] + BPLSIZE - 2;
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 11:
-      custom->bltsize = 1 | ((BLTSIZE / 16) << 6);
-      break;
-
-    case 12:
-      CopInsSet32(bplptr[0], bpl[3]);
-      CopInsSet32(bplptr[1], bpl[2]);
-      CopInsSet32(bplptr[2], bpl[1]);
-      CopInsSet32(bplptr[3], bpl[0]);
-      break;
-
-    default:
-      break;
-  }
+  ClearIRQ(INTF_BLIT);
 
-  c2p.phase++;
+  if (C2PStep(c2p)) {
+    short i;
 
-  ClearIRQ(INTF_BLIT);
+    for (i = 0; i < DEPTH; i++)
+      CopInsSet32(bplptr[i], c2p->planes[i]);
+  }
 }
 
 static void MakeCopperList(CopListT *cp) {
@@ -283,6 +170,8 @@ static void MakeCopperList(CopListT *cp) {
 }
 
 static void Init(void) {
+  short i;
+
   screen[0] = NewBitmap(WIDTH * 4, HEIGHT, DEPTH);
   screen[1] = NewBitmap(WIDTH * 4, HEIGHT, DEPTH);
 
@@ -292,6 +181,12 @@ static void Init(void) {
   chunky[0] = MemAlloc((WIDTH * 4) * HEIGHT, MEMF_CHIP);
   chunky[1] = MemAlloc((WIDTH * 4) * HEIGHT, MEMF_CHIP);
 
+  /* Second half of chunky buffer is used as scratch by c2p. */
+  for (i = 0; i < 2; i++)
+    C2PSetup(&conv[i], C2P_1X1_HAM6_MANGLED, WIDTH, HEIGHT,
+             chunky[i], (void *)chunky[i] + (WIDTH * 4) * HEIGHT / 2,
+             screen[i]->planes);
+
   EnableDMA(DMAF_BLITTER);
 
   BitmapClear(screen[0]);
@@ -374,9 +269,8 @@ static void Render(void) {
   }
   ProfilerStop(BumpMapRender);
 
-  c2p.phase = 0;
-  c2p.chunky = chunky[active];
-  c2p.bpl = screen[active]->planes;
+  c2p = &conv[active];
+  C2PReset(c2p);
   ChunkyToPlanar();
   active ^= 1;
 }
@@ -0,0 +1,163 @@
+#include <effect.h>
+#include <blitter.h>
+#include <c2p.h>
+#include <c2p_1x1_4.h>
+#include <copper.h>
+#include <pixmap.h>
+#include <string.h>
+#include <system/memory.h>
+
+#define WIDTH 160
+#define HEIGHT 128
+#define DEPTH 4
+
+/* Chunky buffers of all formats take the same number of bytes. */
+#define SIZE (WIDTH * HEIGHT / 2)
+
+static BitmapT *screen;
+static BitmapT *wide;
+static CopListT *cp;
+
+/* Source images are kept intact, as some conversions clobber chunky buffer. */
+static PixmapT *source;
+static PixmapT *scrambled;
+static PixmapT *pixels8;
+
+static void *chunky;
+static void *chunky2x1;
+static void *chunkyHam;
+static void *scratch;
+
+static C2PT c2p1x1;
+static C2PT c2pScrambled;
+static C2PT c2p2x1;
+static C2PT c2pHam;
+
+/* Diagonal stripes, so that misplaced bits are easy to spot. */
+static void MakePattern(void) {
+  u_char *dst8 = pixels8->pixels;
+  u_char *dst4 = source->pixels;
+  u_short *ham = chunkyHam;
+  u_char *mangled = chunky2x1;
+  short x, y;
+
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x += 2) {
+      u_char a = ((x + y) >> 3) & 15;
+      u_char b = ((x + 1 + y) >> 3) & 15;
+      *dst8++ = a;
+      *dst8++ = b;
+      *dst4++ = (a << 4) | b;
+    }
+  }
+
+  for (x = 0; x < SIZE / 2; x++)
+    *ham++ = x;
+
+  /* Byte order doesn't matter for timing, only the amount of data does. */
+  memcpy(mangled, source->pixels, SIZE);
+  memcpy(scrambled->pixels, source->pixels, SIZE);
+  PixmapScramble_4_1(scrambled);
+}
+
+static void Load(void) {
+  short i;
+
+  screen = NewBitmap(WIDTH, HEIGHT, DEPTH);
+  wide = NewBitmap(WIDTH * 2, HEIGHT, DEPTH);
+
+  source = NewPixmap(WIDTH, HEIGHT, PM_CMAP4, MEMF_PUBLIC);
+  scrambled = NewPixmap(WIDTH, HEIGHT, PM_CMAP4, MEMF_PUBLIC);
+  pixels8 = NewPixmap(WIDTH, HEIGHT, PM_CMAP8, MEMF_PUBLIC);
+
+  chunky = MemAlloc(SIZE, MEMF_CHIP);
+  chunky2x1 = MemAlloc(SIZE, MEMF_CHIP);
+  chunkyHam = MemAlloc(SIZE, MEMF_CHIP);
+  scratch = MemAlloc(SIZE, MEMF_CHIP);
+
+  MakePattern();
+
+  SetupPlayfield(MODE_LORES, DEPTH, X(80), Y(64), WIDTH, HEIGHT);
+  for (i = 0; i < 16; i++)
+    SetColor(i, i * 0x111);
+
+  cp = NewCopList(100);
+  CopInit(cp);
+  CopSetupBitplanes(cp, NULL, screen, DEPTH);
+  CopEnd(cp);
+}
+
+static void UnLoad(void) {
+  DeleteCopList(cp);
+  MemFree(scratch);
+  MemFree(chunkyHam);
+  MemFree(chunky2x1);
+  MemFree(chunky);
+  DeletePixmap(pixels8);
+  DeletePixmap(scrambled);
+  DeletePixmap(source);
+  DeleteBitmap(wide);
+  DeleteBitmap(screen);
+}
+
+static void Init(void) {
+  C2PSetup(&c2p1x1, C2P_1X1_4BPL, WIDTH, HEIGHT,
+           chunky, scratch, screen->planes);
+  C2PSetup(&c2pScrambled, C2P_1X1_4BPL_SCRAMBLED, WIDTH, HEIGHT,
+           chunky, scratch, screen->planes);
+  C2PSetup(&c2p2x1, C2P_2X1_4BPL_MANGLED, WIDTH, HEIGHT,
+           chunky2x1, scratch, wide->planes);
+  /* HAM6 chunky pixel is a word that yields four screen pixels. */
+  C2PSetup(&c2pHam, C2P_1X1_HAM6_MANGLED, WIDTH / 4, HEIGHT,
+           chunkyHam, scratch, screen->planes);
+
+  CopListActivate(cp);
+  EnableDMA(DMAF_BLITTER | DMAF_RASTER | DMAF_BLITHOG);
+}
+
+/* Profiler reports raster lines spent on converting a 160x128 image in each
+ * format. The 1x1 conversion goes last, so its result is what's displayed. */
+PROFILE(C2P_CPU);
+PROFILE(C2P_HAM6);
+PROFILE(C2P_2X1);
+PROFILE(C2P_Scrambled);
+PROFILE(C2P_1X1);
+
+static void Render(void) {
+  ProfilerStart(C2P_CPU);
+  {
+    c2p_1x1_4(pixels8->pixels, screen->planes[0], WIDTH, HEIGHT,
+              screen->planes[1] - screen->planes[0]);
+  }
+  ProfilerStop(C2P_CPU);
+
+  ProfilerStart(C2P_HAM6);
+  {
+    C2PRun(&c2pHam);
+  }
+  ProfilerStop(C2P_HAM6);
+
+  ProfilerStart(C2P_2X1);
+  {
+    C2PRun(&c2p2x1);
+  }
+  ProfilerStop(C2P_2X1);
+
+  memcpy(chunky, scrambled->pixels, SIZE);
+
+  ProfilerStart(C2P_Scrambled);
+  {
+    C2PRun(&c2pScrambled);
+  }
+  ProfilerStop(C2P_Scrambled);
+
+  memcpy(chunky, source->pixels, SIZE);
+
+  ProfilerStart(C2P_1X1);
+  {
+    C2PRun(&c2p1x1);
+  }
+  ProfilerStop(C2P_1X1);
+}
+
+EFFECT(c2p_bench, Load, UnLoad, Init, NULL, Render);
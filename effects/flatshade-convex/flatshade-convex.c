@@ -14,6 +14,7 @@ static CopListT *cp;
 static CopInsT *bplptr[DEPTH];
 static BitmapT *screen[2];
 static short active;
+static Box2D bound; /* of visible vertices */
 
 #include "data/flatshade-pal.c"
 #include "data/pilka.c"
@@ -119,7 +120,10 @@ static void TransformVertices(Object3D *object) {
   int m0 = (M->x << 8) - ((M->m00 * M->m01) >> 4);
   int m1 = (M->y << 8) - ((M->m10 * M->m11) >> 4);
 
-  short cnt = 0;
+  bound.minX = WIDTH;
+  bound.minY = HEIGHT;
+  bound.maxX = -1;
+  bound.maxY = -1;
 
   /* WARNING! This modifies camera matrix! */
   M->z -= normfx(M->m20 * M->m21);
@@ -149,13 +153,26 @@ static void TransformVertices(Object3D *object) {
       MULVERTEX2(zp);
       popl(v);
 
-      *dst++ = div16(xp, zp) + WIDTH / 2;  /* div(xp * 256, zp) */
-      *dst++ = div16(yp, zp) + HEIGHT / 2; /* div(yp * 256, zp) */
-      *dst++ = zp;
+      {
+        short xs = div16(xp, zp) + WIDTH / 2;  /* div(xp * 256, zp) */
+        short ys = div16(yp, zp) + HEIGHT / 2; /* div(yp * 256, zp) */
+
+        if (xs < bound.minX)
+          bound.minX = xs;
+        if (xs > bound.maxX)
+          bound.maxX = xs;
+        if (ys < bound.minY)
+          bound.minY = ys;
+        if (ys > bound.maxY)
+          bound.maxY = ys;
+
+        *dst++ = xs;
+        *dst++ = ys;
+        *dst++ = zp;
+      }
 
       src++;
       dst++;
-      cnt++;
     } else {
       src += 4;
       dst += 4;
@@ -287,21 +304,39 @@ static void BitmapClearFast(BitmapT *dst) {
   custom->bltsize = bltsize;
 }
 
-static void BitmapFillFast(BitmapT *dst) {
-  void *bltpt = dst->planes[0] + (dst->bplSize * DEPTH) - 2;
-  u_short bltsize = (0 << 6) | (WIDTH >> 4);
+/* Only visible vertices have edges drawn between them, hence filling their
+ * bounding box (rounded out to word boundary) in each bitplane is enough. */
+static void BitmapFillBox(BitmapT *dst, const Box2D *box) {
+  short minX = (box->minX & ~15) >> 3;
+  short maxX = ((box->maxX + 16) & ~15) >> 3;
+  short w = maxX - minX;
+  short h = box->maxY - box->minY + 1;
+  void *bltpt = dst->planes[0] + maxX + box->maxY * (WIDTH / 8) - 2;
+  u_short bltmod = (WIDTH / 8) - w;
+  u_short bltsize = (h << 6) | (w >> 1);
+  short n = DEPTH;
+
+  if (box->minX > box->maxX)
+    return;
 
   WaitBlitter();
 
-  custom->bltapt = bltpt;
-  custom->bltdpt = bltpt;
-  custom->bltamod = 0;
-  custom->bltdmod = 0;
+  custom->bltamod = bltmod;
+  custom->bltdmod = bltmod;
   custom->bltcon0 = (SRCA | DEST) | A_TO_D;
   custom->bltcon1 = BLITREVERSE | FILL_XOR;
   custom->bltafwm = -1;
   custom->bltalwm = -1;
-  custom->bltsize = bltsize;
+
+  while (--n >= 0) {
+    WaitBlitter();
+
+    custom->bltapt = bltpt;
+    custom->bltdpt = bltpt;
+    custom->bltsize = bltsize;
+
+    bltpt += dst->bplSize;
+  }
 
   WaitBlitter();
 }
@@ -333,7 +368,7 @@ static void Render(void) {
 
   ProfilerStart(Fill);
   {
-    BitmapFillFast(screen[active]); // 287 lines
+    BitmapFillBox(screen[active], &bound);
   }
   ProfilerStop(Fill);
 
@@ -3,6 +3,8 @@
 #include "copper.h"
 #include "3d.h"
 #include "fx.h"
+#include "polyfill.h"
+#include <system/memory.h>
 
 #define WIDTH  256
 #define HEIGHT 256
@@ -13,6 +15,8 @@ static CopListT *cp;
 static CopInsT *bplptr[DEPTH];
 static BitmapT *screen0, *screen1;
 static BitmapT *buffer;
+static PolyFillT fill;
+static Point2D *point;
 
 #include "data/flatshade-pal.c"
 #include "data/pilka.c"
@@ -20,10 +24,18 @@ static BitmapT *buffer;
 static Mesh3D *mesh = &pilka;
 
 static void Load(void) {
+  short i, n = 0;
+
   CalculateFaceNormals(mesh);
+
+  /* Vertices of a face are gathered before it's drawn. */
+  for (i = 0; i < mesh->faces; i++)
+    n = max(n, mesh->face[i]->count);
+  point = MemAlloc(sizeof(Point2D) * n, MEMF_PUBLIC);
 }
 
 static void UnLoad(void) {
+  MemFree(point);
   ResetMesh3D(mesh);
 }
 
@@ -123,195 +135,33 @@ static void TransformVertices(Object3D *object) {
   } while (--n != -1);
 }
 
-static void DrawObject(Object3D *object, CustomPtrT custom_ asm("a6")) {
+static void DrawObject(Object3D *object) {
   IndexListT **faces = object->mesh->face;
   SortItemT *item = object->visibleFace;
   char *faceFlags = object->faceFlags;
   short n = object->visibleFaces;
-  void *point = object->vertex;
-  void *temp = buffer->planes[0];
+  Point3D *vertex = object->vertex;
 
-  custom_->bltafwm = -1;
-  custom_->bltalwm = -1;
+  PolyFillInit(&fill, screen0, buffer);
 
   for (; --n >= 0; item++) {
     short index = item->index;
     IndexListT *face = faces[index];
-
-    short minX, minY, maxX, maxY;
-
-    /* Draw edges and calculate bounding box. */
-    {
-      short *i = face->indices;
-      register short m asm("d7") = face->count - 1;
-      short *ptr = (short *)(point + (short)(i[m] << 3));
-      short xs = *ptr++;
-      short ys = *ptr++;
-      short xe, ye;
-
-      minX = xs;
-      minY = ys;
-      maxX = xs;
-      maxY = ys;
-
-      do {
-        ptr = (short *)(point + (short)(*i++ << 3));
-        xe = *ptr++;
-        ye = *ptr++;
-
-        /* Estimate the size of rectangle that contains a face. */
-        if (xe < minX)
-          minX = xe;
-        else if (xe > maxX)
-          maxX = xe;
-        if (ye < minY)
-          minY = ye;
-        else if (ye > maxY)
-          maxY = ye;
-
-        /* Draw an edge. */
-        {
-          short x0, y0, dx, dy, derr;
-          u_short bltcon1;
-
-          if (ys < ye) {
-            x0 = xs; y0 = ys;
-            dx = xe - xs;
-            dy = ye - ys;
-          } else {
-            x0 = xe; y0 = ye;
-            dx = xs - xe;
-            dy = ys - ye;
-          }
-
-          if (dx < 0) {
-            dx = -dx;
-            if (dx >= dy) {
-              bltcon1 = AUL | SUD | LINEMODE | ONEDOT;
-            } else {
-              bltcon1 = SUL | LINEMODE | ONEDOT;
-              swapr(dx, dy);
-            }
-          } else {
-            if (dx >= dy) {
-              bltcon1 = SUD | LINEMODE | ONEDOT;
-            } else {
-              bltcon1 = LINEMODE | ONEDOT;
-              swapr(dx, dy);
-            }
-          }
-
-          derr = dy + dy - dx;
-          if (derr < 0)
-            bltcon1 |= SIGNFLAG;
-
-          {
-            short start = ((y0 << 5) + (x0 >> 3)) & ~1;
-            void *dst = temp + start;
-            u_short bltcon0 = rorw(x0 & 15, 4) | BC0F_LINE_EOR;
-            u_short bltamod = derr - dx;
-            u_short bltbmod = dy + dy;
-            u_short bltsize = (dx << 6) + 66;
-
-            WaitBlitter();
-
-            custom_->bltbdat = 0xffff;
-            custom_->bltadat = 0x8000;
-            custom_->bltcon0 = bltcon0;
-            custom_->bltcon1 = bltcon1;
-            custom_->bltcpt = dst;
-            custom_->bltapt = (void *)(int)derr;
-            custom_->bltdpt = temp;
-            custom_->bltcmod = WIDTH / 8;
-            custom_->bltbmod = bltbmod;
-            custom_->bltamod = bltamod;
-            custom_->bltdmod = WIDTH / 8;
-            custom_->bltsize = bltsize;
-          }
-        }
-
-        xs = xe; ys = ye;
-      } while (--m != -1);
+    short *i = face->indices;
+    Point2D *p = point;
+    short m = face->count;
+
+    while (--m >= 0) {
+      Point3D *v = &vertex[*i++];
+      p->x = v->x;
+      p->y = v->y;
+      p++;
     }
 
-    {
-      short bltstart, bltend;
-      u_short bltmod, bltsize;
-
-      /* Align to word boundary. */
-      minX = (minX & ~15) >> 3;
-      /* to avoid case where a line is on right edge */
-      maxX = ((maxX + 16) & ~15) >> 3;
-
-      {
-        short w = maxX - minX;
-        short h = maxY - minY + 1;
-
-        bltstart = minX + minY * (WIDTH / 8);
-        bltend = maxX + maxY * (WIDTH / 8) - 2;
-        bltsize = (h << 6) | (w >> 1);
-        bltmod = (WIDTH / 8) - w;
-      }
-
-      /* Fill face. */
-      {
-        void *src = temp + bltend;
-
-        WaitBlitter();
-
-        custom_->bltcon0 = (SRCA | DEST) | A_TO_D;
-        custom_->bltcon1 = BLITREVERSE | FILL_XOR;
-        custom_->bltapt = src;
-        custom_->bltdpt = src;
-        custom_->bltamod = bltmod;
-        custom_->bltbmod = bltmod;
-        custom_->bltdmod = bltmod;
-        custom_->bltsize = bltsize;
-      }
-
-      /* Copy filled face to screen. */
-      {
-        void **screen = &screen0->planes[DEPTH];
-        void *src = temp + bltstart;
-        char mask = 1 << (DEPTH - 1);
-        char color = faceFlags[index];
-        short n = DEPTH;
-
-        while (--n >= 0) {
-          void *dst = *(--screen) + bltstart;
-          u_short bltcon0;
-
-          if (color & mask)
-            bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
-           else
-            bltcon0 = (SRCA | SRCB | DEST) | (NABC | NABNC);
-
-          WaitBlitter();
-
-          custom_->bltcon0 = bltcon0;
-          custom_->bltcon1 = 0;
-          custom_->bltapt = src;
-          custom_->bltbpt = dst;
-          custom_->bltdpt = dst;
-          custom_->bltsize = bltsize;
-
-          mask >>= 1;
-        }
-      }
-
-      /* Clear working area. */
-      {
-        void *data = temp + bltstart;
-
-        WaitBlitter();
-
-        custom_->bltcon0 = (DEST | A_TO_D);
-        custom_->bltadat = 0;
-        custom_->bltdpt = data;
-        custom_->bltsize = bltsize;
-      }
-    }
+    PolyFillAdd(&fill, point, face->count, faceFlags[index]);
   }
+
+  PolyFillFlush(&fill);
 }
 
 static void BitmapClearFast(BitmapT *dst) {
@@ -350,7 +200,7 @@ static void Render(void) {
 
   ProfilerStart(Draw);
   {
-    DrawObject(cube, custom);
+    DrawObject(cube);
   }
   ProfilerStop(Draw);
 
@@ -8,6 +8,7 @@
 #include <effect.h>
 #include <color.h>
 #include <copper.h>
+#include <coppatch.h>
 #include <fx.h>
 #include <gfx.h>
 
@@ -22,6 +23,8 @@ static CopListT *coplist[2];
 static short active = 0;
 
 static CopInsT *copLine[2][HEIGHT];
+/* Colors 1-15 set every 8 lines, slot index is (line / 8) * 15 + color - 1 */
+static CopPatchT *colors;
 
 /* A struct that controls stripe's colors */
 typedef struct {
@@ -80,7 +83,7 @@ static void MakeCopperList(CopListT *cp, short n) {
       short j;
 
       for (j = 1; j < 16; j++)
-        CopSetColor(cp, j, 0);
+        CopPatchSlot(colors, n, (i >> 3) * 15 + j - 1, CopSetColor(cp, j, 0));
     }
   }
 
@@ -111,6 +114,7 @@ static void Init(void) {
 
   coplist[0] = NewCopList(100 + 2 * HEIGHT + 15 * HEIGHT / 8);
   coplist[1] = NewCopList(100 + 2 * HEIGHT + 15 * HEIGHT / 8);
+  colors = NewCopPatch(15 * HEIGHT / 8);
 
   MakeCopperList(coplist[0], 0);
   MakeCopperList(coplist[1], 1);
@@ -121,6 +125,7 @@ static void Init(void) {
 
 static void Kill(void) {
   DisableDMA(DMAF_RASTER);
+  DeleteCopPatch(colors);
   DeleteCopList(coplist[0]);
   DeleteCopList(coplist[1]);
 }
@@ -144,12 +149,14 @@ static void ShiftColors(short offset) {
 /*
  * Calculate the color of the stripe,
  * taking the light intesivity into consideration.
+ * Most stripes keep their colors for many frames, so copper patch writes
+ * into copper list only these that have changed.
  */
-static void ColorizeStripes(CopInsT **stripeLine) {
+static void ColorizeStripes(void) {
   short i;
 
   for (i = 1; i < 16; i++) {
-    CopInsT **line = stripeLine;
+    short slot = i - 1;
     short *light = stripeLight;
     short n = HEIGHT / 8;
     short r, g, b;
@@ -173,12 +180,14 @@ static void ColorizeStripes(CopInsT **stripeLine) {
       /* Write new RGB values back into one variable */
       short color = (tab[r] << 4) | (u_char)(tab[g] | (tab[b] >> 4));
 
-      CopInsSet16(*line + i, color);
+      CopPatchSet(colors, slot, color);
 
       /* Increment the pointers */
-      line += 8; light += 8;
+      slot += 15; light += 8;
     }
   }
+
+  CopPatchFlush(colors, active);
 }
 
 static void ShiftStripes(CopInsT **line, short offset) {
@@ -249,7 +258,7 @@ static void Render(void) {
 
     ControlStripes();
     ShiftColors(offset);
-    ColorizeStripes(line);
+    ColorizeStripes();
     ShiftStripes(line, offset);
   }
   ProfilerStop(Floor);
@@ -13,8 +13,12 @@
  * 2 -> CpuEdge (8550)
  * 3 -> CpuLineOpt (10872)
  * 4 -> CpuEdgeOpt (8253)
+ * 5 -> BlitterLines
+ * 6 -> BlitterLine vs. BlitterLines (both measured each frame)
  */
-#define LINE 0
+#define LINE 6
+
+#define NLINES (WIDTH / 2 + HEIGHT / 2)
 
 void CpuEdgeOpt(void *bpl asm("a0"), short stride asm("a1"),
                 short xs asm("d0"), short ys asm("d1"),
@@ -27,10 +31,23 @@ void CpuLineOpt(void *bpl asm("a0"), short stride asm("a1"),
 
 static BitmapT *screen;
 static CopListT *cp;
+static Line2D lines[NLINES];
 
 static void Load(void) {
+  Line2D *l = lines;
+  short i;
+
   screen = NewBitmap(WIDTH, HEIGHT, DEPTH);
 
+  /* Same set of lines as drawn one by one by other variants. */
+  for (i = 0; i < WIDTH; i += 2, l++) {
+    l->x1 = i, l->y1 = 0, l->x2 = WIDTH - 1 - i, l->y2 = HEIGHT - 1;
+  }
+
+  for (i = 0; i < HEIGHT; i += 2, l++) {
+    l->x1 = 0, l->y1 = i, l->x2 = WIDTH - 1, l->y2 = HEIGHT - 1 - i;
+  }
+
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(0), WIDTH, HEIGHT);
   SetColor(0, 0x000);
   SetColor(1, 0xfff);
@@ -51,21 +68,56 @@ static void Init(void) {
   EnableDMA(DMAF_BLITTER | DMAF_RASTER | DMAF_BLITHOG);
 }
 
+/* Profiler reports raster lines spent on drawing NLINES lines. Run "make bench"
+ * to get them for all variants, i.e. lines per frame is NLINES * 313 / p50. */
+#if LINE == 6
+/* The same lines are drawn one by one and in a batch. Each scope waits for
+ * the blitter, so time taken by the last line is included. */
+PROFILE(OneByOne);
+PROFILE(Batched);
+
+static void Render(void) {
+  Line2D *l = lines;
+  short i;
+
+  BlitterLineSetup(screen, 0, LINE_OR|LINE_SOLID);
+
+  ProfilerStart(OneByOne);
+  {
+    for (i = 0; i < NLINES; i++, l++)
+      BlitterLine(l->x1, l->y1, l->x2, l->y2);
+    WaitBlitter();
+  }
+  ProfilerStop(OneByOne);
+
+  BlitterLineSetup(screen, 0, LINE_OR|LINE_SOLID);
+
+  ProfilerStart(Batched);
+  {
+    BlitterLines(lines, NLINES);
+    WaitBlitter();
+  }
+  ProfilerStop(Batched);
+}
+#else
 PROFILE(Lines);
 
 static void Render(void) {
   ProfilerStart(Lines);
   {
-    short i;
-
 #if LINE == 2
     CpuEdgeSetup(screen, 0);
 #elif LINE == 1
     CpuLineSetup(screen, 0);
-#elif LINE == 0
+#elif LINE == 0 || LINE == 5
     BlitterLineSetup(screen, 0, LINE_OR|LINE_SOLID);
 #endif
 
+#if LINE == 5
+    BlitterLines(lines, NLINES);
+#else
+    short i;
+
     for (i = 0; i < screen->width; i += 2) {
 #if LINE == 4
       CpuLineOpt(screen->planes[0], screen->bytesPerRow,
@@ -97,8 +149,10 @@ static void Render(void) {
       BlitterLine(0, i, screen->width - 1, screen->height - 1 - i);
 #endif
     }
+#endif
   }
   ProfilerStop(Lines);
 }
+#endif
 
 EFFECT(lines, Load, UnLoad, Init, NULL, Render);
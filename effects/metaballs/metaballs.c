@@ -3,6 +3,7 @@
 #include <blitter.h>
 #include <copper.h>
 #include <fx.h>
+#include <dirtyrects.h>
 #include <system/memory.h>
 
 #define WIDTH 320
@@ -15,6 +16,7 @@ static short active = 0;
 
 static Point2D pos[2][3];
 static BitmapT *carry;
+static DirtyRectsT dirty;
 static CopInsT *bplptr[DEPTH];
 static CopListT *cp;
 
@@ -55,9 +57,10 @@ static void Init(void) {
   }
 
   cp = NewCopList(100);
-  carry = NewBitmap(SIZE + 16, SIZE, 2);
+  carry = NewBitmap(SIZE + 16, SIZE, 1);
 
   SetInitialPositions();
+  DirtyRectsInit(&dirty, 2, NULL);
 
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(0), WIDTH, HEIGHT);
   LoadPalette(&metaball_pal, 0);
@@ -67,27 +70,19 @@ static void Init(void) {
   CopEnd(cp);
   CopListActivate(cp);
   EnableDMA(DMAF_RASTER);
+
+  BlitterQueueInit();
 }
 
 static void Kill(void) {
+  BlitterQueueKill();
+
   DisableDMA(DMAF_COPPER | DMAF_RASTER | DMAF_BLITTER | DMAF_BLITHOG);
 
   DeleteBitmap(carry);
   DeleteCopList(cp);
 }
 
-static void ClearMetaballs(void) {
-  Area2D mball = {0, 0, SIZE + 16, SIZE};
-  short *val = (short *)pos[active];
-  short n = 3;
-
-  while (--n >= 0) {
-    mball.x = *val++ & ~15;
-    mball.y = *val++;
-    BitmapClearArea(screen[active], &mball);
-  }
-}
-
 static void PositionMetaballs(void) {
   int t = frameCount * 24;
   short *val = (short *)pos[active];
@@ -108,6 +103,20 @@ static void DrawMetaballs(void) {
   x = *val++; y = *val++; BitmapCopyFast(screen[active], x, y, &metaball);
   x = *val++; y = *val++; BitmapAddSaturated(screen[active], x, y, &metaball, carry);
   x = *val++; y = *val++; BitmapAddSaturated(screen[active], x, y, &metaball, carry);
+
+  /* Metaballs overlap, so their areas usually merge into one or two. */
+  {
+    Area2D mball = {0, 0, SIZE + 16, SIZE};
+    short n = 3;
+
+    val = (short *)pos[active];
+
+    while (--n >= 0) {
+      mball.x = *val++ & ~15;
+      mball.y = *val++;
+      DirtyRectsAdd(&dirty, &mball);
+    }
+  }
 }
 
 PROFILE(Metaballs);
@@ -115,16 +124,19 @@ PROFILE(Metaballs);
 static void Render(void) {
   ProfilerStart(Metaballs);
   {
-    // This takes about 100 lines. Could we do better?
-    ClearMetaballs();
+    DirtyRectsRestore(&dirty, screen[active]);
     PositionMetaballs();
     DrawMetaballs();
+    /* Blits are carried out in background while the CPU sets up next ones.
+     * The buffer must be complete before it's displayed. */
+    BlitterSync();
   }
   ProfilerStop(Metaballs);
 
   ITER(i, 0, DEPTH - 1, CopInsSet32(bplptr[i], screen[active]->planes[i]));
   TaskWaitVBlank();
   active ^= 1;
+  DirtyRectsFlip(&dirty);
 }
 
 EFFECT(metaballs, Load, UnLoad, Init, Kill, Render);
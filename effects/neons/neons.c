@@ -4,6 +4,7 @@
 #include "blitter.h"
 #include "2d.h"
 #include "fx.h"
+#include "dirtyrects.h"
 #include <stdlib.h>
 #include <system/interrupt.h>
 
@@ -42,7 +43,7 @@ static CopInsT *pal;
 #include "data/greet_ycrew.c"
 #include "data/neons.c"
 
-static Area2D grt_area[2][PNUM];
+static DirtyRectsT dirty;
 
 typedef struct {
   short color;
@@ -131,6 +132,8 @@ static void Init(void) {
   BlitterClear(screen[0], 4);
   BlitterClear(screen[1], 4);
 
+  DirtyRectsInit(&dirty, 2, &background);
+
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(0), WIDTH, HEIGHT);
 
   cp = NewCopList(100);
@@ -155,28 +158,8 @@ static void Kill(void) {
   DeleteCopList(cp);
 }
 
-static void ClearCliparts(void) {
-  Area2D *area = grt_area[active];
-  BitmapT *dst = screen[active];
-  short n = PNUM;
-
-  while (--n >= 0) {
-    Area2D neon = *area++;
-
-    if (neon.h > 0) {
-      if (neon.h > 8) {
-        neon.y += neon.h - 8;
-        neon.h = 8; 
-      }
-      BlitterClearArea(dst, 4, &neon);
-      BitmapCopyArea(dst, neon.x, neon.y, &background, &neon);
-    }
-  }
-}
-
 static void DrawCliparts(void) {
   GreetingT *grt = greeting;
-  Area2D *area = grt_area[active];
   BitmapT *dst = screen[active];
   short step = (frameCount - lastFrameCount) * 3;
   short n = PNUM;
@@ -194,21 +177,21 @@ static void DrawCliparts(void) {
       Area2D bg_area = { grt->pos.x, dy, src->width, sh };
       Area2D fg_area = { 0, sy, src->width, sh };
 
-      area->x = grt->pos.x;
-      area->y = dy;
-      area->w = src->width;
-      area->h = sh;
-
       BitmapCopyArea(dst, grt->pos.x, dy, src, &fg_area);
       BlitterSetArea(dst, 3, &bg_area, grt->color ? 0 : -1);
       BlitterSetArea(dst, 4, &bg_area, -1);
-    } else {
-      area->h = 0;
+
+      /* Greetings move up, so next time this buffer is drawn to, they will
+       * cover the area except a few bottom lines. */
+      if (bg_area.h > 8) {
+        bg_area.y += bg_area.h - 8;
+        bg_area.h = 8;
+      }
+      DirtyRectsAdd(&dirty, &bg_area);
     }
 
     grt->pos.y -= step;
     grt++;
-    area++;
   }
 }
 
@@ -218,7 +201,7 @@ static void Render(void) {
   ProfilerStart(RenderNeons);
   {
     WaitBlitter();
-    ClearCliparts();
+    DirtyRectsRestore(&dirty, screen[active]);
     DrawCliparts();
   }
   ProfilerStop(RenderNeons);
@@ -226,6 +209,7 @@ static void Render(void) {
   ITER(i, 0, DEPTH - 1, CopInsSet32(bplptr[i], screen[active]->planes[i]));
   TaskWaitVBlank();
   active ^= 1;
+  DirtyRectsFlip(&dirty);
 }
 
 EFFECT(neons, Load, UnLoad, Init, Kill, Render);
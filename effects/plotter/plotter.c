@@ -40,7 +40,7 @@ static void Init(void) {
     BitmapCopyArea(flare[i], 0, 0, &flares, &flare_area);
   }
 
-  carry = NewBitmap(SIZE + 16, SIZE, 2);
+  carry = NewBitmap(SIZE + 16, SIZE, 1);
   cp = NewCopList(50);
 
   for (i = 0; i < 2; i++)
@@ -1,5 +1,6 @@
 #include <effect.h>
 #include <blitter.h>
+#include <c2p.h>
 #include <copper.h>
 #include <fx.h>
 #include <pixmap.h>
@@ -9,7 +10,6 @@
 #define WIDTH 160
 #define HEIGHT 100
 #define DEPTH 4
-#define FULLPIXEL 1
 
 static u_short *textureHi, *textureLo;
 static BitmapT *screen[2];
@@ -57,138 +57,41 @@ static void PixmapToTexture(const PixmapT *image,
   }
 }
 
-static struct {
-  short phase;
-  void **bpl;
-} c2p = { 256, NULL };
-
-#define BLTSIZE ((WIDTH / 2) * HEIGHT) /* 8000 bytes */
+static C2PT conv[2];
+static C2PT *c2p = &conv[0];
 
 /* If you think you can speed it up (I doubt it) please first look into
  * `c2p_2x1_4bpl_mangled_fast_blitter.py` in `prototypes/c2p`. */
 
 static void ChunkyToPlanar(void) {
-  register void **bpl asm("a0") = c2p.bpl;
-
-  /*
-   * Our chunky buffer of size (WIDTH/2, HEIGHT/2) is stored in bpl[0].
-   * Each 32-bit long word of chunky buffer contains eight 4-bit pixels
-   * [a b c d e f g h] in scrambled format described below.
-   * Please note that a_i is the i-th least significant bit of a.
-   *
-   * [a0 a1 b0 b1 a2 a3 b2 b3 e0 e1 f0 f1 e2 e3 f2 f3
-   *  c0 c1 d0 d1 c2 c3 d2 d3 g0 g1 h0 h1 g2 g3 h2 h3]
-   *
-   * So not only pixels in the texture must be scrambled, but also consecutive
-   * bytes of input buffer i.e.: [a b] [e f] [c d] [g h] (see `gen-uvmap.py`).
-   *
-   * Chunky to planar is divided into two major steps:
-   * 
-   * Swap 4x2: in two consecutive 16-bit words swap diagonally two bits,
-   *           i.e. [b0 b1] <-> [c0 c1], [b2 b3] <-> [c2 c3].
-   * Expand 2x1: [x0 x1 ...] is translated into [x0 x0 ...] and [x1 x1 ...]
-   *             and copied to corresponding bitplanes, this step effectively
-   *             stretches pixels to 2x1.
-   *
-   * Line doubling is performed using copper. Rendered bitmap will have size
-   * (WIDTH, HEIGHT/2, DEPTH) and will be placed in bpl[2] and bpl[3].
-   */
-
   ClearIRQ(INTF_BLIT);
 
-  switch (c2p.phase) {
-    case 0:
-      /* Initialize chunky to planar. */
-      custom->bltamod = 2;
-      custom->bltbmod = 2;
-      custom->bltdmod = 0;
-      custom->bltcdat = 0xF0F0;
-      custom->bltafwm = -1;
-      custom->bltalwm = -1;
-
-      /* Swap 4x2, pass 1, high-bits. */
-      custom->bltapt = bpl[0];
-      custom->bltbpt = bpl[0] + 2;
-      custom->bltdpt = bpl[1] + BLTSIZE / 2;
-
-      /* (a & 0xF0F0) | ((b >> 4) & ~0xF0F0) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-      custom->bltcon1 = BSHIFT(4);
-
-    case 1:
-      /* overall size: BLTSIZE / 2 bytes */
-      custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 2:
-      /* Swap 4x2, pass 2, low-bits. */
-      custom->bltapt = bpl[1] - 4;
-      custom->bltbpt = bpl[1] - 2;
-      custom->bltdpt = bpl[1] + BLTSIZE / 2 - 2;
-
-      /* ((a << 4) & 0xF0F0) | (b & ~0xF0F0) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(4);
-      custom->bltcon1 = BLITREVERSE;
-
-    case 3:
-      /* overall size: BLTSIZE / 2 bytes */
-      custom->bltsize = 1 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 4:
-      custom->bltamod = 0;
-      custom->bltbmod = 0;
-      custom->bltdmod = 0;
-      custom->bltcdat = 0xAAAA;
-
-      custom->bltapt = bpl[1];
-      custom->bltbpt = bpl[1];
-      custom->bltdpt = bpl[3];
-
-#if FULLPIXEL
-      /* (a & 0xAAAA) | ((b >> 1) & ~0xAAAA) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC);
-      custom->bltcon1 = BSHIFT(1);
-#else
-      /* (a & 0xAAAA) */
-      custom->bltcon0 = (SRCA | DEST) | (ABC | ANBC);
-      custom->bltcon1 = 0;
-#endif
-      /* overall size: BLTSIZE bytes */
-      custom->bltsize = 4 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 5:
-      custom->bltapt = bpl[1] + BLTSIZE - 2;
-      custom->bltbpt = bpl[1] + BLTSIZE - 2;
-      custom->bltdpt = bpl[2] + BLTSIZE - 2;
-      custom->bltcdat = 0xAAAA;
-
-#if FULLPIXEL
-      /* ((a << 1) & 0xAAAA) | (b & ~0xAAAA) */
-      custom->bltcon0 = (SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC) | ASHIFT(1);
-      custom->bltcon1 = BLITREVERSE;
-#else
-      /* (a & ~0xAAAA) */
-      custom->bltcon0 = (SRCA | DEST) | (ABNC | ANBNC);
-      custom->bltcon1 = BLITREVERSE;
-#endif
-      /* overall size: BLTSIZE bytes */
-      custom->bltsize = 4 | ((BLTSIZE / 8) << 6);
-      break;
-
-    case 6:
-      CopInsSet32(bplptr[0], bpl[2]);
-      CopInsSet32(bplptr[1], bpl[3]);
-      CopInsSet32(bplptr[2], bpl[2] + BLTSIZE / 2);
-      CopInsSet32(bplptr[3], bpl[3] + BLTSIZE / 2);
-      break;
-
-    default:
-      break;
+  if (C2PStep(c2p)) {
+    short i;
+
+    for (i = 0; i < DEPTH; i++)
+      CopInsSet32(bplptr[i], c2p->planes[i]);
   }
+}
 
-  c2p.phase++;
+/*
+ * Our chunky buffer of size (WIDTH/2, HEIGHT/2) is stored in bpl[0] and
+ * bpl[1] serves as scratch buffer. Rendered bitmap will have size
+ * (WIDTH, HEIGHT/2, DEPTH) and will be placed in bpl[2] and bpl[3].
+ * Line doubling is performed using copper.
+ */
+static void SetupChunkyToPlanar(void) {
+  short i;
+
+  for (i = 0; i < 2; i++) {
+    void **bpl = screen[i]->planes;
+    void *planes[4] = { bpl[2], bpl[3],
+                        bpl[2] + WIDTH * HEIGHT / 4,
+                        bpl[3] + WIDTH * HEIGHT / 4 };
+
+    C2PSetup(&conv[i], C2P_2X1_4BPL_MANGLED, WIDTH, HEIGHT,
+             bpl[0], bpl[1], planes);
+  }
 }
 
 static void MakeCopperList(CopListT *cp) {
@@ -202,10 +105,6 @@ static void MakeCopperList(CopListT *cp) {
     /* Line doubling. */
     CopMove16(cp, bpl1mod, (i & 1) ? 0 : -40);
     CopMove16(cp, bpl2mod, (i & 1) ? 0 : -40);
-#if !FULLPIXEL
-    /* Alternating shift by one for bitplane data. */
-    CopMove16(cp, bplcon1, (i & 1) ? 0x0010 : 0x0021);
-#endif
   }
   CopEnd(cp);
 }
@@ -218,6 +117,8 @@ static void Init(void) {
   textureLo = MemAlloc(texture.width * texture.height * 4, MEMF_PUBLIC);
   PixmapToTexture(&texture, textureHi, textureLo);
 
+  SetupChunkyToPlanar();
+
   EnableDMA(DMAF_BLITTER);
 
   BitmapClear(screen[0]);
@@ -225,7 +126,7 @@ static void Init(void) {
 
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(28), WIDTH * 2, HEIGHT * 2);
 
-  cp = NewCopList(HEIGHT * 2 * (4 - FULLPIXEL) + 50);
+  cp = NewCopList(HEIGHT * 2 * 3 + 50);
   MakeCopperList(cp);
   CopListActivate(cp);
 
@@ -304,8 +205,8 @@ static void Render(void) {
   Rotator();
   ProfilerStop(Rotator);
 
-  c2p.phase = 0;
-  c2p.bpl = screen[active]->planes;
+  c2p = &conv[active];
+  C2PReset(c2p);
   ChunkyToPlanar();
   active ^= 1;
 }
@@ -0,0 +1,37 @@
+#include <effect.h>
+#include <system/part.h>
+
+/* Parts are run in order. Terminated with an entry without a path. */
+static PartT Parts[] = {
+  PART("plasma.part"),
+  PART("ball.part"),
+  PART("uvmap.part"),
+  PART(NULL)
+};
+
+/* Trackmo provides its own main() instead of running single effect. */
+int main(void) {
+  PartT *part;
+
+  /* NOP that triggers fs-uae debugger to stop and inform GDB that it should
+   * fetch segments locations to relocate symbol information read from file. */
+  asm volatile("exg %d7,%d7");
+
+  for (part = Parts; part->path; part++) {
+    PartT *next = part + 1;
+
+    if (!PartWait(part))
+      return 1;
+
+    /* Read next part while current one is running. Peak memory usage is then
+     * the sum of two consecutive parts. Remove the call to trade loading time
+     * for memory - then only one part is kept in memory at a time. */
+    if (next->path)
+      PartLoadAsync(next);
+
+    PartRun(part);
+    PartUnLoad(part);
+  }
+
+  return 0;
+}
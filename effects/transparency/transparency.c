@@ -2,7 +2,7 @@
 #include "copper.h"
 #include "gfx.h"
 #include "color.h"
-#include "blitter.h"
+#include "blitchain.h"
 #include "fx.h"
 
 #define WIDTH   320
@@ -12,6 +12,10 @@
 static BitmapT *screen;
 static CopListT *cp;
 static CopInsT *pal;
+static CopInsT *call;
+static CopListT *chain[2];
+static CopBlitT blit[2][2];
+static short active = 0;
 
 #include "data/ghostown-logo.c"
 #include "data/transparency-bg.c"
@@ -19,34 +23,31 @@ static CopInsT *pal;
 #define pal1 background_pal.colors
 #define pal2 logo_pal.colors
 
-static void BitplaneCopyFast(BitmapT *dst, short d, u_short x, u_short y,
-                             const BitmapT *src, short s)
-{
-  void *srcbpt = src->planes[s];
-  void *dstbpt = dst->planes[d] + ((x & ~15) >> 3) + y * dst->bytesPerRow;
-  u_short dstmod = dst->bytesPerRow - src->bytesPerRow;
-  u_short bltsize = (src->height << 6) | (src->bytesPerRow >> 1);
-  u_short bltshift = rorw(x & 15, 4);
-
-  WaitBlitter();
-
-  if (bltshift) {
-    bltsize += 1; dstmod -= 2;
-
-    custom->bltalwm = 0;
-    custom->bltamod = -2;
-  } else {
-    custom->bltalwm = -1;
-    custom->bltamod = 0;
+/* Logo is blitted into bitplanes 3 and 4 by copper in vertical blank. As the
+ * chain is patched while the other one may be running, they're double
+ * buffered. */
+static void MakeBlitChain(CopListT *list, CopBlitT *ins) {
+  BlitT blits[2];
+  short i;
+
+  /* Blit one more word than needed, so the shift can be patched freely. */
+  for (i = 0; i < 2; i++) {
+    blits[i] = (BlitT){
+      .bltcon0 = (SRCA | DEST) | A_TO_D,
+      .bltcon1 = 0,
+      .bltafwm = -1,
+      .bltalwm = 0,
+      .bltamod = -2,
+      .bltdmod = screen->bytesPerRow - logo.bytesPerRow - 2,
+      .bltapt = logo.planes[i],
+      .bltdpt = screen->planes[3 + i],
+      .bltsize = (logo.height << 6) | ((logo.bytesPerRow >> 1) + 1)
+    };
   }
 
-  custom->bltdmod = dstmod;
-  custom->bltcon0 = (SRCA | DEST | A_TO_D) | bltshift;
-  custom->bltcon1 = 0;
-  custom->bltafwm = -1;
-  custom->bltapt = srcbpt;
-  custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  CopInit(list);
+  CopBlitChain(list, blits, 2, ins);
+  CopEnd(list);
 }
 
 static void Init(void) {
@@ -58,18 +59,30 @@ static void Init(void) {
   SetupPlayfield(MODE_LORES, DEPTH, X(0), Y(0), WIDTH, HEIGHT);
   LoadPalette(&background_pal, 0);
 
+  chain[0] = NewCopList(2 * COPBLIT_MAXINS + 1);
+  chain[1] = NewCopList(2 * COPBLIT_MAXINS + 1);
+  MakeBlitChain(chain[0], blit[0]);
+  MakeBlitChain(chain[1], blit[1]);
+
   cp = NewCopList(100);
   CopInit(cp);
   CopSetupBitplanes(cp, NULL, screen, DEPTH);
   pal = CopLoadColor(cp, 8, 31, 0);
+  call = CopJump(cp, chain[active]->entry);
   CopEnd(cp);
 
+  CopBlitChainEnable();
   CopListActivate(cp);
   EnableDMA(DMAF_RASTER);
 }
 
 static void Kill(void) {
+  DisableDMA(DMAF_COPPER | DMAF_RASTER);
+  CopBlitChainDisable();
+
   DeleteBitmap(screen);
+  DeleteCopList(chain[0]);
+  DeleteCopList(chain[1]);
   DeleteCopList(cp);
 }
 
@@ -77,11 +90,21 @@ static void Render(void) {
   short xo = normfx(SIN(frameCount * 8) * 32);
   short yo = normfx(SIN(frameCount * 16) * 32);
   short s = normfx(SIN(frameCount * 64) * 6) + 8;
+  short x = 80 + xo;
+  short y = 64 + yo;
+  int offset = ((x & ~15) >> 3) + y * screen->bytesPerRow;
+  u_short bltcon0 = (SRCA | DEST | A_TO_D) | rorw(x & 15, 4);
   short i;
 
-  BitplaneCopyFast(screen, 3, 80 + xo, 64 + yo, &logo, 0);
-  BitplaneCopyFast(screen, 4, 80 + xo, 64 + yo, &logo, 1);
-  
+  active ^= 1;
+
+  for (i = 0; i < 2; i++) {
+    CopInsSet16(blit[active][i].bltcon0, bltcon0);
+    CopInsSet32(blit[active][i].bltdpt, screen->planes[3 + i] + offset);
+  }
+
+  CopInsSet32(call, chain[active]->entry);
+
   for (i = 0; i < 24; i++)
     CopInsSet16(pal + i, ColorTransition(pal1[i & 7], pal2[i / 8 + 1], s));
 
@@ -1,9 +1,11 @@
 #include <effect.h>
 #include <blitter.h>
 #include <copper.h>
+#include <coppatch.h>
 #include <fx.h>
 #include <pixmap.h>
 #include <sprite.h>
+#include <string.h>
 #include <system/memory.h>
 
 #define WIDTH   144
@@ -14,9 +16,12 @@
 static CopListT *cp[2];
 static CopInsT *bplptr[2][DEPTH];
 static CopInsT *bplmod[2][HEIGHT];
-static CopInsT *colors[2][HEIGHT];
 static short active = 0;
 
+/* Texture rows are kept in color MOVEs of every third line. */
+static CopPatchT *colors;
+static u_short *texels;
+
 static CopInsT *sprptr[2][8];
 
 #include "data/twister-gradient.c"
@@ -45,9 +50,8 @@ static void MakeCopperList(CopListT **ptr, short n) {
     CopSetColor(cp, 0, gradient.colors[i]);
 
     if ((i % 3) == 0) {
-      colors[n][k++] = CopSetColor(cp, 1, *pixels++);
-      for (j = 2; j < 32; j++)
-        CopSetColor(cp, j, *pixels++);
+      for (j = 1; j < 32; j++, k++)
+        CopPatchSlot(colors, n, k, CopSetColor(cp, j, *pixels++));
     }
   }
 
@@ -68,6 +72,15 @@ static void Init(void) {
   custom->diwstrt = 0x2c81;
   custom->diwstop = 0x2bc1;
 
+  {
+    int size = texture.width * texture.height * sizeof(u_short);
+
+    /* Copper patch copies texture rows with the blitter. */
+    texels = MemAlloc(size, MEMF_CHIP);
+    memcpy(texels, texture.pixels, size);
+    colors = NewCopPatch(texture.width * texture.height);
+  }
+
   MakeCopperList(&cp[0], 0);
   MakeCopperList(&cp[1], 1);
 
@@ -83,6 +96,8 @@ static void Init(void) {
 static void Kill(void) {
   DeleteCopList(cp[0]);
   DeleteCopList(cp[1]);
+  DeleteCopPatch(colors);
+  MemFree(texels);
 }
 
 static inline short rotate(short f) {
@@ -120,58 +135,15 @@ static void SetupLines(short f) {
   }
 }
 
-static void SetupTexture(CopInsT **colors, short y) {
-  short *pixels = texture.pixels;
+/* Texture scrolls by a row each frame, so all slots change. */
+static void SetupTexture(short y) {
   short height = texture.height;
   short width = texture.width;
-  short n = height;
 
   y %= height;
 
-  pixels += y * width;
-
-  while (--n >= 0) {
-    short *ins = (short *)(*colors++) + 1;
-
-    ins[0] = *pixels++;
-    ins[2] = *pixels++;
-    ins[4] = *pixels++;
-    ins[6] = *pixels++;
-    ins[8] = *pixels++;
-    ins[10] = *pixels++;
-    ins[12] = *pixels++;
-    ins[14] = *pixels++;
-    ins[16] = *pixels++;
-    ins[18] = *pixels++;
-    ins[20] = *pixels++;
-    ins[22] = *pixels++;
-    ins[24] = *pixels++;
-    ins[26] = *pixels++;
-    ins[28] = *pixels++;
-    ins[30] = *pixels++;
-    ins[32] = *pixels++;
-    ins[34] = *pixels++;
-    ins[36] = *pixels++;
-    ins[38] = *pixels++;
-    ins[40] = *pixels++;
-    ins[42] = *pixels++;
-    ins[44] = *pixels++;
-    ins[46] = *pixels++;
-    ins[48] = *pixels++;
-    ins[50] = *pixels++;
-    ins[52] = *pixels++;
-    ins[54] = *pixels++;
-    ins[56] = *pixels++;
-    ins[58] = *pixels++;
-    ins[60] = *pixels++;
-
-    y++;
-
-    if (y >= height) {
-      pixels = texture.pixels;
-      y = 0;
-    }
-  }
+  CopPatchCopy(colors, 0, texels + y * width, (height - y) * width);
+  CopPatchCopy(colors, (height - y) * width, texels, y * width);
 }
 
 PROFILE(TwisterRGB);
@@ -179,8 +151,9 @@ PROFILE(TwisterRGB);
 static void Render(void) {
   ProfilerStart(TwisterRGB);
   {
+    SetupTexture(frameCount);
     SetupLines(frameCount * 16);
-    SetupTexture(colors[active], frameCount);
+    CopPatchFlush(colors, active);
   }
   ProfilerStop(TwisterRGB);
 
@@ -40,6 +40,37 @@ BitmapT *NewBitmapCustom(u_short width, u_short height, u_short depth,
 void DeleteBitmap(BitmapT *bitmap);
 void BitmapMakeDisplayable(BitmapT *bitmap);
 
+/* Number of bytes between consecutive rows of a single bitplane. */
+static inline u_short BitmapStride(const BitmapT *bitmap) {
+  if (bitmap->flags & BM_INTERLEAVED)
+    return bitmap->bytesPerRow * bitmap->depth;
+  return bitmap->bytesPerRow;
+}
+
+/* Describes interleaved bitmap as a single bitplane that is `depth` times
+ * taller, so all bitplanes can be processed by one blit. Row `y` of original
+ * bitmap starts at row `y * depth` of the flat one. */
+static inline void BitmapFlatten(BitmapT *flat, const BitmapT *bitmap) {
+  flat->width = bitmap->width;
+  flat->height = bitmap->height * bitmap->depth;
+  flat->depth = 1;
+  flat->bytesPerRow = bitmap->bytesPerRow;
+  flat->bplSize = bitmap->bplSize * bitmap->depth;
+  flat->flags = bitmap->flags & ~BM_INTERLEAVED;
+  flat->planes[0] = bitmap->planes[0];
+  flat->planes[1] = bitmap->planes[bitmap->depth];
+}
+
+/* Both bitmaps are interleaved, have the same number of bitplanes and their
+ * flattened versions are not taller than blitter can process in one go
+ * (1024 rows). */
+static inline bool BitmapFlattenable(const BitmapT *dst, const BitmapT *src) {
+  return (dst->flags & src->flags & BM_INTERLEAVED) &&
+         (dst->depth == src->depth) &&
+         (dst->height * dst->depth <= 1024) &&
+         (src->height * src->depth <= 1024);
+}
+
 static inline BitmapT *NewBitmap(u_short width, u_short height, u_short depth) {
   return NewBitmapCustom(width, height, depth, BM_CLEAR|BM_DISPLAYABLE);
 }
@@ -0,0 +1,85 @@
+#ifndef __BLITCHAIN_H__
+#define __BLITCHAIN_H__
+
+#include <blitter.h>
+#include <copper.h>
+
+/* Blitter chain is a copper list segment that carries out a sequence of blits
+ * without CPU intervention. Each blit waits for the previous one to finish and
+ * then loads blitter registers with MOVE instructions. CPU only patches channel
+ * pointers (with CopInsSet32) or bltcon0 and bltsize (with CopInsSet16).
+ *
+ * Copper can write blitter registers only if COPCON danger bit is set, so call
+ * CopBlitChainEnable before the chain is run. The copper is stalled for the
+ * time the chain is executed, hence it should be called from a place in main
+ * copper list that does not need precise timing, e.g. before display window
+ * starts. The chain is cut off when copper restarts at vertical blank.
+ *
+ * CPU must not use the blitter while the chain is running! */
+
+typedef struct Blit {
+  u_short bltcon0;
+  u_short bltcon1;
+  u_short bltafwm;
+  u_short bltalwm;
+  short bltamod;
+  short bltbmod;
+  short bltcmod;
+  short bltdmod;
+  u_short bltadat;
+  u_short bltbdat;
+  u_short bltcdat;
+  void *bltapt;
+  void *bltbpt;
+  void *bltcpt;
+  void *bltdpt;
+  u_short bltsize;
+} BlitT;
+
+/* Instructions of a compiled blit that can be patched by CPU. Pointers of
+ * channels that are not enabled in bltcon0 are set to NULL. */
+typedef struct CopBlit {
+  CopInsT *bltcon0;
+  CopInsT *bltapt;
+  CopInsT *bltbpt;
+  CopInsT *bltcpt;
+  CopInsT *bltdpt;
+  CopInsT *bltsize;
+} CopBlitT;
+
+/* Maximum number of copper instructions taken by a single blit. */
+#define COPBLIT_MAXINS 22
+
+static inline void CopBlitChainEnable(void) {
+  custom->copcon = CDANG;
+}
+
+static inline void CopBlitChainDisable(void) {
+  custom->copcon = 0;
+}
+
+/* Wait for blitter to finish. Beam position is masked out completely. */
+static inline CopInsT *CopWaitBlitter(CopListT *list) {
+  CopInsT *pos = list->curr;
+  CopInsT *ins = list->curr;
+  *((u_int *)ins)++ = 0x00010000;
+  list->curr = ins;
+  return pos;
+}
+
+/* Continue execution at given instruction (possibly in other copper list).
+ * Uses COP2LC, so it can be patched later with CopInsSet32. */
+static inline CopInsT *CopJump(CopListT *list, CopInsT *target) {
+  CopInsT *pos = CopMove32(list, cop2lc, target);
+  CopMove16(list, copjmp2, 0);
+  return pos;
+}
+
+/* Compiles `n` blits into copper list. Only the first blit loads all blitter
+ * registers. Each subsequent one reloads these that differ from its
+ * predecessor. Pointers, bltcon0 and bltsize are always reloaded, as these are
+ * expected to be patched. If `ins` is not NULL, instructions of each blit
+ * that can be patched are stored there. */
+void CopBlitChain(CopListT *list, const BlitT *blits, short n, CopBlitT *ins);
+
+#endif /* !__BLITCHAIN_H__ */
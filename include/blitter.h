@@ -61,6 +61,14 @@
 #define HALF_SUB ((SRCA | SRCB | DEST) | A_XOR_B)
 #define HALF_SUB_BORROW ((SRCA | SRCB | DEST) | (NABC | NABNC))
 
+/* Carry (borrow) recovered from one operand (A), sum (difference) bit (B) and
+ * previous carry (borrow) (C). Allows to compute it in place after sum bit
+ * overwrote the other operand. */
+#define ADD_CARRY                                                              \
+  ((SRCA | SRCB | SRCC | DEST) | (ABC | ANBC | ANBNC | NANBC))
+#define SUB_BORROW                                                             \
+  ((SRCA | SRCB | SRCC | DEST) | (ABC | ANBC | ABNC | NABC))
+
 #define BC0F_LINE_OR ((ABC | ABNC | NABC | NANBC) | (SRCA | SRCC | DEST))
 #define BC0F_LINE_EOR ((ABNC | NABC | NANBC) | (SRCA | SRCC | DEST))
 
@@ -86,7 +94,56 @@ static inline void _WaitBlitter(CustomPtrT custom_) {
       :: "a" (custom_));
 }
 
+#ifdef BLITSTATS
+#include <system/blitstats.h>
+#define WaitBlitter() _WaitBlitterStats()
+#else
 #define WaitBlitter() _WaitBlitter(custom)
+#endif
+
+/*
+ * Asynchronous blitter queue. After BlitterQueueInit libblit routines do not
+ * program the blitter directly. They write blitter registers to a shadow
+ * register set, which is appended to the queue when the blit is started.
+ * Blitter interrupt handler starts queued blits one after another, while
+ * the CPU carries on with its work.
+ *
+ * BlitterSync waits for all queued blits to finish. Use it before the CPU
+ * accesses results of blits, or before programming the blitter directly.
+ * Each queued blit reloads all blitter registers, so channel pointers do
+ * not carry over from previous blit.
+ *
+ * The queue takes blitter interrupt, so it can't be used together with other
+ * users of the interrupt, e.g. effects that run C2PStep from their own blitter
+ * interrupt handler. BlitterQueueInit panics if the interrupt is already
+ * enabled. With BLITSTATS the queue must be set up in effect's Init, as
+ * blitter statistics get chained in front of the handler installed there.
+ */
+#define BLITQ_SIZE 64 /* must be power of two */
+
+extern volatile struct Custom *_BlitterQueue;
+
+void BlitterQueueInit(void);
+void BlitterQueueKill(void);
+void BlitterSync(void);
+void _BlitterQueueStart(u_short bltsize);
+
+/* Returns where blitter registers for next blit are to be written. */
+static inline volatile struct Custom *BlitterBegin(void) {
+  volatile struct Custom *blt = _BlitterQueue;
+  if (!blt) {
+    WaitBlitter();
+    blt = custom;
+  }
+  return blt;
+}
+
+static inline void BlitterStart(volatile struct Custom *blt, u_short bltsize) {
+  if (blt == custom)
+    custom->bltsize = bltsize;
+  else
+    _BlitterQueueStart(bltsize);
+}
 
 /* Blitter copy. */
 void BlitterCopySetup(const BitmapT *dst, u_short x, u_short y,
@@ -175,12 +232,60 @@ void BlitterLineSetupFull(const BitmapT *bitmap, u_short plane,
 void BlitterLine(short x1 asm("d2"), short y1 asm("d3"),
                  short x2 asm("d4"), short y2 asm("d5"));
 
-/* Other operations. */
-void BitmapAddSaturated(const BitmapT *dst, short dx, short dy,
-                        const BitmapT *src, const BitmapT *carry);
+/* Draws `n` lines with settings given to BlitterLineSetup. Lines shorter than
+ * LINE_CPU_MAX pixels along both axes are plotted by CPU, unless the mode is
+ * LINE_ONEDOT or line pattern is not solid. */
+#define LINE_CPU_MAX 4
+
+void BlitterLines(const Line2D *lines, short n);
+
+/*
+ * Bit-sliced arithmetic. Bitplanes of a bitmap store bits of unsigned
+ * numbers, bitplane 0 being the least significant one. Operands must have
+ * the same depth. Carry and borrow are kept in the first bitplane of scratch
+ * bitmap, which must be at least as large as the operands.
+ */
+#define ARITH_SUB __BIT(0)
+#define ARITH_SATURATE __BIT(1)
+
+/* `dst += src` (or `dst -= src`) with `src` placed at given position. */
+void _BitmapAddSub(const BitmapT *dst, short dx, short dy,
+                   const BitmapT *src, const BitmapT *carry, u_short flags);
+
+#define BitmapAdd(dst, dx, dy, src, carry)                                     \
+  _BitmapAddSub((dst), (dx), (dy), (src), (carry), 0)
+#define BitmapSub(dst, dx, dy, src, borrow)                                    \
+  _BitmapAddSub((dst), (dx), (dy), (src), (borrow), ARITH_SUB)
+#define BitmapAddSaturated(dst, dx, dy, src, carry)                            \
+  _BitmapAddSub((dst), (dx), (dy), (src), (carry), ARITH_SATURATE)
+#define BitmapSubSaturated(dst, dx, dy, src, borrow)                           \
+  _BitmapAddSub((dst), (dx), (dy), (src), (borrow),                            \
+                ARITH_SUB | ARITH_SATURATE)
+
+/* `dst = src - 1` and `dst = src + carry[0]`, `dst` may be same as `src`. */
+void BitmapDecSaturated(const BitmapT *dst, const BitmapT *src,
+                        const BitmapT *borrow);
+void BitmapIncSaturated(const BitmapT *dst, const BitmapT *src,
+                        const BitmapT *carry);
+
+/* `lt[0] = a < b` */
+void BitmapCompare(const BitmapT *lt, const BitmapT *a, const BitmapT *b);
+
+/* `dst = min(dst, src)` and `dst = max(dst, src)` */
+void _BitmapMinMax(const BitmapT *dst, const BitmapT *src,
+                   const BitmapT *scratch, bool max);
+
+#define BitmapMin(dst, src, scratch) _BitmapMinMax((dst), (src), (scratch), 0)
+#define BitmapMax(dst, src, scratch) _BitmapMinMax((dst), (src), (scratch), 1)
+
+/* `dst = (dst + src) / 2` */
+void BitmapAverage(const BitmapT *dst, const BitmapT *src,
+                   const BitmapT *carry);
+
+/* `bm = bm / 2` */
+void BitmapShiftRight(const BitmapT *bm);
 
-void BitmapDecSaturated(const BitmapT *dst_bm, const BitmapT *borrow_bm);
-void BitmapIncSaturated(const BitmapT *dst_bm, const BitmapT *carry_bm);
+/* Other operations. */
 
 BitmapT *BitmapMakeMask(const BitmapT *bitmap);
 
@@ -0,0 +1,45 @@
+#ifndef __BOB_H__
+#define __BOB_H__
+
+#include <gfx.h>
+#include <dirtyrects.h>
+
+/*
+ * Bobs are software sprites drawn with the blitter. Bob image may be a sheet
+ * of frames laid out horizontally, each `width` pixels wide. Mask is computed
+ * from the image when it's registered, unless the image is to be or'ed with
+ * the screen. If the image is interleaved then so is its mask, and a bob gets
+ * drawn into interleaved screen with a single blit.
+ *
+ * Bobs are clipped to ClipWin. Horizontal edges of clipping window get
+ * rounded outwards to word boundary. Bobs must be narrower than ClipWin.
+ */
+
+#define BOB_OR 1 /* or image with screen instead of cookie-cutting it */
+
+typedef struct BobImage {
+  const BitmapT *bitmap;
+  BitmapT *mask;
+  u_short width, height; /* of single frame, width must be divisible by 16 */
+  u_short flags;
+} BobImageT;
+
+typedef struct Bob {
+  const BobImageT *image;
+  short x, y;
+  short frame;
+} BobT;
+
+void InitBobImage(BobImageT *image, const BitmapT *bitmap, u_short width,
+                  u_short flags);
+
+static inline void KillBobImage(BobImageT *image) {
+  if (image->mask)
+    DeleteBitmap(image->mask);
+}
+
+/* Draws `n` bobs into `dst`. The array gets sorted by vertical position.
+ * If `dirty` is not NULL, areas taken by bobs are recorded there. */
+void DrawBobs(const BitmapT *dst, BobT *bobs, short n, DirtyRectsT *dirty);
+
+#endif /* !__BOB_H__ */
@@ -0,0 +1,67 @@
+#ifndef __C2P_H__
+#define __C2P_H__
+
+#include <blitchain.h>
+
+/*
+ * Blitter chunky-to-planar conversion. Data flow of each format is modelled
+ * by a script in `prototypes/c2p`, so please look there first. Conversion is
+ * compiled into a sequence of blits once per set of buffers, then it can be
+ * run at once with C2PRun, or blit by blit with C2PStep. Compiled blits can
+ * also be put into copper list with CopBlitChain.
+ *
+ * Formats produce four bitplanes. Chunky pixels are 4-bit wide, unless stated
+ * otherwise. Chunky buffer takes `width * height / 2` bytes and scratch buffer
+ * must be at least as large. Width must be divisible by 16, except for HAM6
+ * format (see below).
+ *
+ * Blits taller than 1024 rows are split, so larger buffers need more of them.
+ * C2PSetup panics if conversion doesn't fit into C2P_MAXBLITS blits, e.g.
+ * C2P_1X1_4BPL takes 22 blits for 160x128 and all 24 for 160x160 pixels.
+ */
+
+/* Pixels [a b] packed in byte, as in PM_CMAP4 pixmap. Chunky buffer is used
+ * as temporary storage. (see `c2p_1x1_4bpl_blitter.py`) */
+#define C2P_1X1_4BPL 0
+/* As above, but with pixels scrambled by PixmapScramble_4_1, which saves one
+ * swap stage. Scratch buffer may be shared with output bitplanes. */
+#define C2P_1X1_4BPL_SCRAMBLED 1
+/* Pixels and bytes mangled as described in the prototype, each pixel stretched
+ * to 2x1. Output bitplanes are twice as large as for 1x1 formats. Chunky
+ * buffer is preserved. (see `c2p_2x1_4bpl_mangled_fast_blitter.py`) */
+#define C2P_2X1_4BPL_MANGLED 2
+/* Chunky pixels are 16-bit words with mangled [r g b b] components, which
+ * are displayed as four consecutive pixels in HAM6 mode. Width is given in
+ * chunky pixels and must be divisible by 4, so that a row of bitplane takes
+ * a whole number of words. Chunky buffer takes `width * height * 2` bytes.
+ * (see `c2p_1x1_ham6_mangled_blitter.py`) */
+#define C2P_1X1_HAM6_MANGLED 3
+
+#define C2P_MAXBLITS 24
+
+typedef struct C2P {
+  short phase; /* index of next blit to start */
+  short count;
+  void *planes[4]; /* output bitplanes */
+  BlitT blit[C2P_MAXBLITS];
+} C2PT;
+
+/* Leaves conversion in finished state, i.e. C2PStep won't start any blit. */
+void C2PSetup(C2PT *c2p, u_short format, short width, short height,
+              void *chunky, void *scratch, void *planes[4]);
+
+/* Runs whole conversion and waits for it to finish. */
+void C2PRun(C2PT *c2p);
+
+/* Starts conversion over. Follow with C2PStep to start the first blit. */
+static inline void C2PReset(C2PT *c2p) {
+  c2p->phase = 0;
+}
+
+/* Starts next blit of the conversion. Call it from blitter interrupt handler,
+ * so that the conversion runs in background, possibly across frames. Returns
+ * true (only once) when the last blit has finished, i.e. bitplanes are ready
+ * to be displayed. Don't use it together with blitter queue! */
+bool C2PStep(C2PT *c2p);
+
+#endif /* !__C2P_H__ */
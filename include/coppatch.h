@@ -0,0 +1,76 @@
+#ifndef __COPPATCH_H__
+#define __COPPATCH_H__
+
+#include <copper.h>
+
+/*
+ * Copper patch keeps track of MOVE instructions (slots) of double-buffered
+ * copper lists that an effect modifies every frame. Each slot is identified
+ * by an index (an effect may name them with an enum) and has its instruction
+ * recorded in both lists. Effect sets new slot values, but only these which
+ * changed since the list was last shown are written into it before the flip,
+ * so copper list maintenance time is proportional to the amount of change.
+ *
+ * Slots changed one by one with CopPatchSet are compared with their current
+ * value and queued per list. Blocks of slots set with CopPatchCopy are kept
+ * as dirty ranges instead. Runs of at least COPPATCH_BLITMIN consecutive
+ * MOVEs within a range (e.g. a row of color registers) are written by the
+ * blitter, the rest by the CPU. Slot values are kept in chip memory, so that
+ * the blitter can read them.
+ *
+ * Per frame usage is:
+ *  1. CopPatchSet or CopPatchCopy for slots that may have changed,
+ *  2. CopPatchFlush on the list that is about to be shown.
+ */
+
+#define COPPATCH_RANGES 8
+
+/* Number of consecutive slots from which the blitter writes them faster. */
+#define COPPATCH_BLITMIN 16
+
+/* Bits of slot flags. */
+#define COPPATCH_QUEUED 0x01  /* slot is queued for list n (bit n) */
+#define COPPATCH_NEXT 0x04    /* slot follows previous one in list n (bit n) */
+
+typedef struct CopPatchRange {
+  short first, last;
+} CopPatchRangeT;
+
+typedef struct CopPatch {
+  short count;
+  u_short *value;         /* current value of each slot (in chip memory) */
+  u_char *flags;
+  CopInsT **slot[2];      /* instruction of each slot in both lists */
+  short *queue[2];        /* slots set one by one since list was flushed */
+  short queued[2];
+  short ranges[2];
+  CopPatchRangeT range[2][COPPATCH_RANGES];
+} CopPatchT;
+
+CopPatchT *NewCopPatch(short count);
+void DeleteCopPatch(CopPatchT *patch);
+
+/* Records instruction of slot `i` in list `n`. Slots must be recorded in
+ * ascending order. Slot value is taken from the instruction. */
+CopInsT *CopPatchSlot(CopPatchT *patch, short n, short i, CopInsT *ins);
+
+void _CopPatchQueue(CopPatchT *patch, short i);
+
+static inline void CopPatchSet(CopPatchT *patch, short i, u_short data) {
+  if (patch->value[i] != data) {
+    patch->value[i] = data;
+    _CopPatchQueue(patch, i);
+  }
+}
+
+/* Sets `n` consecutive slots starting from `i` with words from `data`, which
+ * must be in chip memory, as they're copied by the blitter. Values are not
+ * compared, so use it when most of them change anyway. Don't CopPatchSet
+ * these slots before the next CopPatchFlush. */
+void CopPatchCopy(CopPatchT *patch, short i, const u_short *data, short n);
+
+/* Writes slots that changed since last call into list `n`. Waits for the
+ * blitter to finish if it was used. */
+void CopPatchFlush(CopPatchT *patch, short n);
+
+#endif /* !__COPPATCH_H__ */
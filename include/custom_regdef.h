@@ -190,6 +190,9 @@ struct Custom {
 
 #define INTF_ALL 0x3FFF
 
+/* defines for copcon register */
+#define CDANG __BIT(1) /* copper can write to blitter registers */
+
 /* defines for beamcon register */
 #define VARVBLANK __BIT(12)  /* Variable vertical blank enable */
 #define LOLDIS __BIT(11)     /* long line disable */
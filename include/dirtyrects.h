@@ -0,0 +1,50 @@
+#ifndef __DIRTYRECTS_H__
+#define __DIRTYRECTS_H__
+
+#include <gfx.h>
+
+/*
+ * Dirty rectangles keep track of screen areas that were drawn over, so that
+ * only these (instead of whole screen) get cleared or restored from background
+ * bitmap before the buffer is drawn to again. Each screen buffer has its own
+ * list, hence double and triple buffering are supported.
+ *
+ * Rectangles are extended to word boundaries, so restoring them takes the
+ * fast path of blitter routines. Overlapping or nearby rectangles are merged
+ * when a single blit of their bounding box is cheaper than separate ones.
+ *
+ * Per frame usage is:
+ *  1. DirtyRectsRestore on active buffer,
+ *  2. DirtyRectsAdd for everything drawn into active buffer,
+ *  3. DirtyRectsFlip when active buffer changes.
+ */
+
+#define DIRTY_BUFFERS 3
+#define DIRTY_MAX 32
+
+/* Estimated cost of starting a blit, expressed in words of blitted area. */
+#define DIRTY_OVERHEAD 16
+
+typedef struct DirtyList {
+  short count;
+  Area2D area[DIRTY_MAX];
+} DirtyListT;
+
+typedef struct DirtyRects {
+  const BitmapT *background; /* if NULL then areas are cleared */
+  short buffers;
+  short active;
+  DirtyListT list[DIRTY_BUFFERS];
+} DirtyRectsT;
+
+void DirtyRectsInit(DirtyRectsT *dirty, short buffers,
+                    const BitmapT *background);
+void DirtyRectsAdd(DirtyRectsT *dirty, const Area2D *area);
+void DirtyRectsRestore(DirtyRectsT *dirty, const BitmapT *dst);
+
+static inline void DirtyRectsFlip(DirtyRectsT *dirty) {
+  if (++dirty->active == dirty->buffers)
+    dirty->active = 0;
+}
+
+#endif /* !__DIRTYRECTS_H__ */
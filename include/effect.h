@@ -94,19 +94,44 @@ void EffectRun(EffectT *effect);
     .Render = (R),                  \
   };                                \
 
+/*
+ * Profiler measures number of raster lines spent in a scope in each frame.
+ * Scopes can be nested, i.e. Render -> Transform -> Sort -> Draw. History of
+ * last PROFILE_FRAMES frames is kept and reported by ProfilerDump (called
+ * when an effect finishes) as p50/p95/max percentiles.
+ *
+ * Pass "PROFILER=0" to make to compile out all profiling scopes.
+ *
+ * Pass "RASTERBARS=1" to make to set background color while a scope runs,
+ * so the frame budget can be read off the screen. Each scope gets a distinct
+ * color, and the color of enclosing scope is restored on ProfilerStop.
+ */
+#define PROFILE_FRAMES 256 /* must be power of two */
+
 typedef struct Profile {
   const char *name;
-  u_int lines, total;
-  u_short min, max;
-  u_short count;
+  struct Profile *parent; /* scope that was active on ProfilerStart */
+  struct Profile *next;   /* scopes that were started since last dump */
+  u_int start;            /* line counter value on ProfilerStart */
+  u_int count;            /* number of frames in which scope was active */
+  int frame;              /* frame of the most recent sample */
+  u_short *history;       /* raster lines per frame (ring buffer) */
+  u_short color;          /* background color for raster bars */
 } ProfileT;
 
+#ifdef PROFILER
 #define PROFILE(NAME)                                                          \
+  static u_short _##NAME##_history[PROFILE_FRAMES];                            \
   static ProfileT *_##NAME##_profile = &(ProfileT){                            \
-    .name = #NAME, .lines = 0, .total = 0, .min = 65535, .max = 0, .count = 0};
+    .name = #NAME, .frame = -1, .history = _##NAME##_history};
 
 #define ProfilerStart(NAME) _ProfilerStart(_##NAME##_profile)
 #define ProfilerStop(NAME) _ProfilerStop(_##NAME##_profile)
+#else
+#define PROFILE(NAME)
+#define ProfilerStart(NAME) ((void)0)
+#define ProfilerStop(NAME) ((void)0)
+#endif
 
 #include <system/syscall.h>
 
@@ -116,5 +141,6 @@ SYSCALL0NR(TaskWaitVBlank);
 
 SYSCALL1NR(_ProfilerStart, ProfileT *, prof, a0);
 SYSCALL1NR(_ProfilerStop, ProfileT *, prof, a0);
+SYSCALL0NR(ProfilerDump);
 
 #endif /* !__EFFECT_H__ */
@@ -1,6 +1,12 @@
 #ifndef __INFLATE_H__
 #define __INFLATE_H__
 
-void Inflate(const void *input asm("a4"), void *output asm("a5"));
+/* Size of storage area that must be provided to Inflate. */
+#define INFLATE_STORAGE 2928
+
+/* Decompresses raw DEFLATE stream. Storage area is passed by pointer to its
+ * end, so that the routine doesn't need kilobytes of stack. */
+void Inflate(const void *input asm("a5"), void *output asm("a4"),
+             void *storageEnd asm("a6"));
 
 #endif
@@ -0,0 +1,48 @@
+#ifndef __POLYFILL_H__
+#define __POLYFILL_H__
+
+#include <gfx.h>
+
+/*
+ * Blitter polygon filler. Polygon edges are drawn in one-dot mode into
+ * a single bitplane scratch bitmap, which must have the same dimensions as
+ * the target. Then the scratch is filled, but only within polygon's bounding
+ * box rounded out to word boundary. Filled shape is merged into target
+ * bitplanes according to bits of color index and the box is cleared.
+ *
+ * Polygons of the same color are gathered into a batch, as long as their
+ * bounding boxes do not overlap and filling the box that encloses the whole
+ * batch is cheaper than filling each box separately. Overlapping polygons are
+ * drawn in order they were added, so painter's algorithm works as expected.
+ *
+ * Polygons must lie within the target bitmap - clip them beforehand.
+ *
+ * Per frame usage is:
+ *  1. PolyFillAdd for each polygon,
+ *  2. PolyFillFlush to draw the last batch.
+ */
+
+#define POLYFILL_BATCH 8
+#define POLYFILL_EDGES 32
+
+/* Estimated cost of starting a blit, expressed in words of blitted area. */
+#define POLYFILL_OVERHEAD 16
+
+typedef struct PolyFill {
+  const BitmapT *target;
+  const BitmapT *scratch;
+  u_short color;
+  short count;                 /* number of polygons in the batch */
+  Box2D box[POLYFILL_BATCH];   /* of each polygon in the batch */
+  Box2D bound;                 /* of the whole batch */
+  short edges;                 /* number of edges waiting to be drawn */
+  Line2D edge[POLYFILL_EDGES];
+} PolyFillT;
+
+void PolyFillInit(PolyFillT *fill, const BitmapT *target,
+                  const BitmapT *scratch);
+void PolyFillAdd(PolyFillT *fill, const Point2D *points, short n,
+                 u_short color);
+void PolyFillFlush(PolyFillT *fill);
+
+#endif /* !__POLYFILL_H__ */
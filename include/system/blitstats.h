@@ -0,0 +1,30 @@
+#ifndef __SYSTEM_BLITSTATS_H__
+#define __SYSTEM_BLITSTATS_H__
+
+#include <types.h>
+#include <system/syscall.h>
+
+/*
+ * Blitter utilisation counters. For each frame following values are gathered:
+ * - time spent by the CPU inside WaitBlitter,
+ * - number of finished blits (counted by blitter interrupt),
+ * - time during which the blitter was idle while the CPU waited for VBlank
+ *   in TaskWaitVBlank.
+ * Times are measured with beam position, hence in color clocks.
+ *
+ * Pass "BLITSTATS=1" to make to enable counters in each effect run by
+ * EffectRun. Blitter interrupt handler installed by the effect (if any) keeps
+ * running, as counters are chained in front of it.
+ */
+
+SYSCALL0NR(BlitStatsStart);
+SYSCALL0NR(BlitStatsStop);
+
+/* Use WaitBlitter from blitter.h instead of calling this directly. */
+SYSCALL0NR(_WaitBlitterStats);
+
+#ifdef _SYSTEM
+void BlitStatsWaitVBlank(void);
+#endif
+
+#endif /* !__SYSTEM_BLITSTATS_H__ */
@@ -0,0 +1,18 @@
+#ifndef __SYSTEM_BUFFILE_H__
+#define __SYSTEM_BUFFILE_H__
+
+#include <types.h>
+
+struct File;
+
+/*
+ * Wraps any file in a read buffer of given size, so that many small reads
+ * (i.e. a longword at a time) are served from memory instead of going down
+ * to the underlying device on each call.
+ *
+ * The buffered file does not own the underlying file. Closing it releases the
+ * buffer and moves underlying file cursor back to the logical position.
+ */
+struct File *BufOpen(struct File *parent, u_int bufsize);
+
+#endif /* !__SYSTEM_BUFFILE_H__ */
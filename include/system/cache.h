@@ -0,0 +1,19 @@
+#ifndef __SYSTEM_CACHE_H__
+#define __SYSTEM_CACHE_H__
+
+#include <types.h>
+#include <system/syscall.h>
+
+/*
+ * Cache for results of expensive precalculations, kept on RAM disk, so that
+ * they survive an effect being unloaded and loaded again later on.
+ *
+ * CacheLoad copies cached data into the buffer and returns true only if
+ * the entry exists and has exactly the requested size.
+ */
+SYSCALL3(CacheLoad, bool, const char *, name, a0, void *, buf, a1,
+         u_int, size, d0);
+SYSCALL3NR(CacheStore, const char *, name, a0, const void *, buf, a1,
+           u_int, size, d0);
+
+#endif /* !__SYSTEM_CACHE_H__ */
@@ -2,16 +2,51 @@
 #define __SYSTEM_DEBUG_H__
 
 #include <cdefs.h>
+#include <system/syscall.h>
 
-#ifdef UAE
+#ifdef LOGBIN
+/*
+ * Binary deferred logging. Instead of formatting messages on the target,
+ * Log stores address of format string and raw arguments in a ring buffer.
+ * The buffer is drained lazily by LogDrain and decoded on the host with
+ * tools/logdecode using format strings from the executable file.
+ *
+ * Since arguments are not interpreted, "%s" must point to constant data
+ * within the executable, otherwise the host tool prints raw pointer value.
+ *
+ * Parts of a trackmo log into kernel's buffer through system calls.
+ */
+#define __LOGNARGS(...)                                                        \
+  __LOGNARGS1(__VA_ARGS__, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, \
+              10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define __LOGNARGS1(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12,    \
+                    _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, n, \
+                    ...)                                                       \
+  n
+#define Log(...) _LogBin(__LOGNARGS(__VA_ARGS__), __VA_ARGS__)
+#define Panic(...) { Log(__VA_ARGS__); LogDrain(-1); PANIC(); }
+void _LogBin(short nargs, const char *format, ...) SYSCALLVA(_LogBin)
+  __attribute__ ((format (printf, 2, 3)));
+/* Send at most `nlongs` longwords of log buffer (all if negative). */
+SYSCALL1NR(LogDrain, int, nlongs, d0);
+#ifdef _SYSTEM
+struct Hunk;
+/* Tell the host where executable `name` (e.g. a part) has been loaded. */
+void LogHunks(const char *name, struct Hunk *hunks);
+#endif
+#elif defined(UAE)
 #include <uae.h>
 #define Log(...) UaeLog(__VA_ARGS__);
 #define Panic(...) { UaeLog(__VA_ARGS__); PANIC(); }
+#define LogDrain(n) ((void)0)
+#define LogHunks(name, hunks) ((void)0)
 #else
-void Log(const char *format, ...)
+void Log(const char *format, ...) SYSCALLVA(Log)
   __attribute__ ((format (printf, 1, 2)));
-__noreturn void Panic(const char *format, ...)
+__noreturn void Panic(const char *format, ...) SYSCALLVA(Panic)
   __attribute__ ((format (printf, 1, 2)));
+#define LogDrain(n) ((void)0)
+#define LogHunks(name, hunks) ((void)0)
 #endif
 
 #ifdef _SYSTEM
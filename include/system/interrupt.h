@@ -39,6 +39,17 @@ typedef struct IntServer {
   static IntServerT *NAME = &(IntServerT)_INTSERVER(PRI, CODE, DATA)
 
 #ifdef _SYSTEM
+/* Interrupt Vector Entry */
+typedef struct IntVecEntry {
+  IntHandlerT code;
+  void *data;
+} IntVecEntryT;
+
+typedef IntVecEntryT IntVecT[INTB_INTEN];
+
+/* Amiga autovector interrupts table. */
+extern IntVecT IntVec;
+
 void SetupInterruptVector(void);
 #endif
 
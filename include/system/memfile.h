@@ -8,4 +8,8 @@ struct File;
 
 struct File *MemOpen(const void *buf, u_int nbyte);
 
+/* Inflates DEFLATE stream into a buffer of given size allocated in public
+ * memory. The buffer is released when the file is closed. */
+struct File *MemOpenInflate(const void *packed, u_int nbyte);
+
 #endif /* !__SYSTEM_MEMFILE_H__ */
@@ -0,0 +1,36 @@
+#ifndef __SYSTEM_PART_H__
+#define __SYSTEM_PART_H__
+
+#include <types.h>
+
+struct Effect;
+struct Hunk;
+
+/*
+ * Part of a trackmo is an effect linked into separate executable file (see
+ * "%.part" rule in build/effect.mk), that is loaded from disk on demand.
+ * Kernel stays resident, while parts only occupy memory between PartLoad and
+ * PartUnLoad calls.
+ */
+typedef struct Part {
+  const char *path;       /* name of the executable in file system image */
+  struct Hunk *hunks;     /* relocated hunks of the executable */
+  struct Effect *effect;  /* effect exported by the executable */
+  volatile bool loading;  /* set while background loader works on the part */
+} PartT;
+
+#define PART(PATH) { .path = (PATH), .hunks = NULL, .effect = NULL }
+
+/* Read the executable, run its constructors and do effect's Load step. */
+bool PartLoad(PartT *part);
+/* Do effect's UnLoad step, run destructors and free the executable. */
+void PartUnLoad(PartT *part);
+/* Do effect's Init step, run it until it finishes and call Kill step. */
+void PartRun(PartT *part);
+
+/* Let background task load the part while current task renders frames. */
+void PartLoadAsync(PartT *part);
+/* Make sure the part has been loaded, waiting for background task if needed. */
+bool PartWait(PartT *part);
+
+#endif /* !__SYSTEM_PART_H__ */
@@ -0,0 +1,23 @@
+#ifndef __SYSTEM_RAMDISK_H__
+#define __SYSTEM_RAMDISK_H__
+
+#include <types.h>
+#include <system/syscall.h>
+
+struct File;
+
+/* Flags for RamOpen. */
+#define RAM_CREATE __BIT(0) /* create the file if it does not exist */
+#define RAM_TRUNC __BIT(1)  /* discard contents of the file */
+#define RAM_CHIP __BIT(2)   /* keep contents of new file in chip memory */
+
+/*
+ * RAM disk keeps named files in memory until they're deleted. File contents
+ * grow as they're written, and are resized with MemResize.
+ *
+ * Returns NULL if the file does not exist and RAM_CREATE was not passed.
+ */
+SYSCALL2(RamOpen, struct File *, const char *, name, a0, u_int, flags, d0);
+SYSCALL1NR(RamDelete, const char *, name, a0);
+
+#endif /* !__SYSTEM_RAMDISK_H__ */
@@ -0,0 +1,32 @@
+#ifndef __SYSTEM_REPLAY_H__
+#define __SYSTEM_REPLAY_H__
+
+#include <types.h>
+
+union Event;
+
+/*
+ * Record and replay of effect timing and input. With "RECORD=1" EffectRun
+ * logs the value of frame counter each time Render is called, and every
+ * input event delivered by PushEventISR. tools/replay.py turns such log
+ * into replay data, which is linked into an effect built with
+ * "REPLAY=<log>". Then EffectRun feeds Render with recorded frame counter
+ * values and events instead of real ones, and stops after the last frame.
+ *
+ * Events are injected just before Render call following their arrival.
+ */
+
+#ifdef _SYSTEM
+#ifdef RECORD
+void RecordFrame(int frame);
+void RecordEvent(union Event *event);
+#endif
+
+#ifdef REPLAY
+/* Fetch next frame counter value and push events that preceded it.
+ * Returns false if that was the last recorded frame. */
+bool ReplayFrame(int *frame);
+#endif
+#endif
+
+#endif /* !__SYSTEM_REPLAY_H__ */
@@ -0,0 +1,20 @@
+#ifndef __SYSTEM_SAMPLER_H__
+#define __SYSTEM_SAMPLER_H__
+
+#include <types.h>
+#include <system/syscall.h>
+
+/*
+ * Statistical profiler. CIA-B timer interrupt records program counter and
+ * task that was running at the time, `rate` times a second. SamplerStop
+ * sends the histogram through Log, to be mapped back to functions and source
+ * lines with tools/pcprof.
+ *
+ * Pass "SAMPLER=<rate>" to make to sample each effect run by EffectRun.
+ */
+#define SAMPLER_SIZE 8192 /* maximum number of samples */
+
+SYSCALL1NR(SamplerStart, u_short, rate, d0);
+SYSCALL0NR(SamplerStop);
+
+#endif /* !__SYSTEM_SAMPLER_H__ */
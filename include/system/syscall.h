@@ -154,4 +154,12 @@
   void name(t1 v1 asm(#r1), t2 v2 asm(#r2), t3 v3 asm(#r3), t4 v4 asm(#r4))
 #endif
 
+/* System calls with variable number of arguments take them on stack, just like
+ * regular functions. Only the symbol is redirected to jump table entry. */
+#ifndef _SYSTEM
+#define SYSCALLVA(name) asm("__" #name)
+#else
+#define SYSCALLVA(name)
+#endif
+
 #endif /* !__SYSTEM_SYSCALL_H__ */
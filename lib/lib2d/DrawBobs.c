@@ -0,0 +1,182 @@
+#include <2d.h>
+#include <blitter.h>
+#include <bob.h>
+
+/* A: mask, B: image, C: screen */
+#define COOKIE_CUT ((SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | NABC | NANBC))
+/* A: image, C: screen. Or'ed bobs don't need a mask, as the image itself goes
+ * through A channel, which has first and last word masks used for clipping. */
+#define IMAGE_OR ((SRCA | SRCC | DEST) | A_OR_C)
+
+/* Bobs move a little between frames, so the array is almost sorted. */
+static void SortBobs(BobT *bobs, short n) {
+  short i, j;
+
+  for (i = 1; i < n; i++) {
+    BobT bob = bobs[i];
+
+    for (j = i; j > 0 && bobs[j - 1].y > bob.y; j--)
+      bobs[j] = bobs[j - 1];
+
+    bobs[j] = bob;
+  }
+}
+
+/* Blitter registers that depend only on bob image, shift and clipping.
+ * These are not reloaded if consecutive bobs share them. */
+typedef struct {
+  const BobImageT *image;
+  u_short bltcon1;
+  u_short bltalwm;
+  short words;
+} SetupT;
+
+void DrawBobs(const BitmapT *dst_bm, BobT *bobs, short n, DirtyRectsT *dirty)
+{
+  short minX = (ClipWin.minX >> 4) & ~15;
+  short maxX = ((ClipWin.maxX >> 4) + 16) & ~15;
+  short minY = ClipWin.minY >> 4;
+  short maxY = (ClipWin.maxY >> 4) + 1;
+  SetupT last = { NULL, 0, 0, 0 };
+  BobT *bob = bobs;
+
+  SortBobs(bobs, n);
+
+  for (; --n >= 0; bob++) {
+    const BobImageT *image = bob->image;
+    const BitmapT *src_bm = image->bitmap;
+    const BitmapT *msk_bm = image->mask;
+    short x = bob->x;
+    short y = bob->y;
+    short h = image->height;
+    short sy = 0;
+    short dx = x & ~15;
+    short s = x & 15;
+    short words = image->width >> 4;
+    short first, count;
+    bool reverse = false;
+    u_short bltalwm;
+    u_short srcx = (bob->frame * image->width) >> 3;
+    short srcstride, mskstride, dststride;
+    u_int src_start, msk_start, dst_start;
+    short depth = 1;
+    BitmapT _src, _msk, _dst;
+    const BitmapT *src = src_bm, *msk = msk_bm, *dst = dst_bm;
+
+    if (y < minY) { sy = minY - y; h -= sy; y = minY; }
+    if (y + h > maxY) { h = maxY - y; }
+    if (h <= 0 || x >= maxX || x + image->width <= minX)
+      continue;
+
+    /* Source word shifted into destination word is the one processed before.
+     * If bob is clipped on the left, the first visible destination word needs
+     * a source word that lies to the left of it - so blit in descending mode.
+     * Clipping on the right doesn't have this problem, but the source bits
+     * shifted out of the last visible word must not leak into next row. */
+    if (x < minX) {
+      if (x + image->width > maxX)
+        continue;
+      first = (minX - dx) >> 4;
+      if (s) {
+        reverse = true;
+        count = words - first + 1;
+        bltalwm = FirstWordMask[16 - s];
+        s = 16 - s;
+        first--;
+      } else {
+        count = words - first;
+        bltalwm = -1;
+      }
+    } else if (x + image->width > maxX) {
+      first = 0;
+      count = (maxX - dx) >> 4;
+      bltalwm = s ? LastWordMask[16 - s] : -1;
+    } else {
+      first = 0;
+      count = s ? words + 1 : words;
+      bltalwm = s ? 0 : -1;
+    }
+
+    if (dirty) {
+      Area2D area = { dx + (first << 4) + (reverse ? 16 : 0), y,
+                      count << 4, h };
+      DirtyRectsAdd(dirty, &area);
+    }
+
+    /* Interleaved bitmaps are drawn with one blit. */
+    if (BitmapFlattenable(dst_bm, src_bm) &&
+        (!msk_bm || BitmapFlattenable(src_bm, msk_bm))) {
+      depth = dst_bm->depth;
+      BitmapFlatten(&_src, src_bm);
+      if (msk_bm)
+        BitmapFlatten(&_msk, msk_bm);
+      BitmapFlatten(&_dst, dst_bm);
+      src = &_src, msk = msk_bm ? &_msk : NULL, dst = &_dst;
+      y *= depth, sy *= depth, h *= depth;
+    }
+
+    srcstride = BitmapStride(src);
+    mskstride = msk ? BitmapStride(msk) : 0;
+    dststride = BitmapStride(dst);
+
+    /* Descending mode starts with the last word of the last row. */
+    if (reverse) {
+      short lastword = (first + count - 1) << 1;
+      sy += h - 1;
+      y += h - 1;
+      src_start = srcx + lastword + sy * srcstride;
+      msk_start = srcx + lastword + sy * mskstride;
+      dst_start = (dx >> 3) + lastword + 2 + y * dststride;
+    } else {
+      src_start = srcx + (first << 1) + sy * srcstride;
+      msk_start = srcx + (first << 1) + sy * mskstride;
+      dst_start = (dx >> 3) + (first << 1) + y * dststride;
+    }
+
+    {
+      u_short bltcon1 = rorw(s, 4) | (reverse ? BLITREVERSE : 0);
+      u_short bltsize = (h << 6) | count;
+      short i, planes = depth > 1 ? 1 : min(dst->depth, src->depth);
+      volatile struct Custom *blt;
+
+      if (last.image != image || last.bltcon1 != bltcon1 ||
+          last.bltalwm != bltalwm || last.words != count)
+      {
+        blt = BlitterBegin();
+        if (msk) {
+          blt->bltcon0 = COOKIE_CUT | rorw(s, 4);
+          blt->bltamod = mskstride - (count << 1);
+          blt->bltbmod = srcstride - (count << 1);
+        } else {
+          blt->bltcon0 = IMAGE_OR | rorw(s, 4);
+          blt->bltamod = srcstride - (count << 1);
+        }
+        blt->bltcon1 = bltcon1;
+        blt->bltafwm = -1;
+        blt->bltalwm = bltalwm;
+        blt->bltcmod = dststride - (count << 1);
+        blt->bltdmod = dststride - (count << 1);
+
+        last.image = image;
+        last.bltcon1 = bltcon1;
+        last.bltalwm = bltalwm;
+        last.words = count;
+      }
+
+      for (i = 0; i < planes; i++) {
+        void *dstbpt = dst->planes[i] + dst_start;
+
+        blt = BlitterBegin();
+        if (msk) {
+          blt->bltapt = msk->planes[0] + msk_start;
+          blt->bltbpt = src->planes[i] + src_start;
+        } else {
+          blt->bltapt = src->planes[i] + src_start;
+        }
+        blt->bltcpt = dstbpt;
+        blt->bltdpt = dstbpt;
+        BlitterStart(blt, bltsize);
+      }
+    }
+  }
+}
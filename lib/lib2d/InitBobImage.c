@@ -0,0 +1,12 @@
+#include <blitter.h>
+#include <bob.h>
+
+void InitBobImage(BobImageT *image, const BitmapT *bitmap, u_short width,
+                  u_short flags)
+{
+  image->bitmap = bitmap;
+  image->mask = (flags & BOB_OR) ? NULL : BitmapMakeMask(bitmap);
+  image->width = width;
+  image->height = bitmap->height;
+  image->flags = flags;
+}
@@ -0,0 +1,112 @@
+#include <blitter.h>
+
+/* Bit-sliced adder (subtractor) of bitmap placed at given position.
+ *
+ * For each bitplane the sum (difference) bit is written into destination
+ * first. Then carry (borrow) is recovered in place from source bit, new
+ * destination bit and previous carry - so a single scratch plane suffices.
+ * Carry out of the most significant plane is not computed unless the result
+ * is saturated. */
+void _BitmapAddSub(const BitmapT *dst_bm, short dx, short dy,
+                   const BitmapT *src_bm, const BitmapT *carry_bm,
+                   u_short flags)
+{
+  u_int dst_begin = ((dx & ~15) >> 3) + dy * (short)BitmapStride(dst_bm);
+  u_short dst_modulo = (BitmapStride(dst_bm) - src_bm->bytesPerRow) - 2;
+  u_short src_modulo = (BitmapStride(src_bm) - src_bm->bytesPerRow) - 2;
+  u_short carry_modulo = (BitmapStride(carry_bm) - src_bm->bytesPerRow) - 2;
+  u_short src_shift = rorw(dx & 15, 4);
+  u_short bltsize = ((src_bm->height << 6) | (src_bm->bytesPerRow >> 1)) + 1;
+  bool saturate = flags & ARITH_SATURATE;
+  u_short carry_op = (flags & ARITH_SUB) ? SUB_BORROW : ADD_CARRY;
+  void *carry = carry_bm->planes[0];
+  void *const *src = src_bm->planes;
+  void *const *dst = dst_bm->planes;
+  short n = src_bm->depth;
+  volatile struct Custom *blt;
+
+  {
+    void *aptr = (*src++);
+    void *bptr = (*dst++) + dst_begin;
+
+    blt = BlitterBegin();
+
+    /* Initialize blitter */
+    blt->bltamod = src_modulo;
+    blt->bltbmod = dst_modulo;
+    blt->bltcmod = carry_modulo;
+    blt->bltcon1 = 0;
+    blt->bltafwm = -1;
+    blt->bltalwm = 0;
+
+    /* Bitplane 0: half adder (subtractor). */
+    blt->bltapt = aptr;
+    blt->bltbpt = bptr;
+    blt->bltdpt = bptr;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = HALF_ADDER | src_shift;
+    BlitterStart(blt, bltsize);
+
+    /* There's no carry coming in, so C channel is effectively zero. */
+    if (n > 1 || saturate) {
+      blt = BlitterBegin();
+      blt->bltapt = aptr;
+      blt->bltbpt = bptr;
+      blt->bltcdat = 0;
+      blt->bltdpt = carry;
+      blt->bltdmod = carry_modulo;
+      blt->bltcon0 = (carry_op & ~SRCC) | src_shift;
+      BlitterStart(blt, bltsize);
+    }
+  }
+
+  /* Bitplane 1-n: full adder (subtractor). */
+  while (--n > 0) {
+    void *aptr = (*src++);
+    void *bptr = (*dst++) + dst_begin;
+
+    blt = BlitterBegin();
+    blt->bltapt = aptr;
+    blt->bltbpt = bptr;
+    blt->bltcpt = carry;
+    blt->bltdpt = bptr;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = FULL_ADDER | src_shift;
+    BlitterStart(blt, bltsize);
+
+    if (n > 1 || saturate) {
+      blt = BlitterBegin();
+      blt->bltapt = aptr;
+      blt->bltbpt = bptr;
+      blt->bltcpt = carry;
+      blt->bltdpt = carry;
+      blt->bltdmod = carry_modulo;
+      blt->bltcon0 = carry_op | src_shift;
+      BlitterStart(blt, bltsize);
+    }
+  }
+
+  /* Apply saturation bits. */
+  if (saturate) {
+    n = src_bm->depth;
+    dst = dst_bm->planes;
+
+    blt = BlitterBegin();
+    blt->bltamod = dst_modulo;
+    blt->bltbmod = carry_modulo;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = (SRCA | SRCB | DEST) |
+      ((flags & ARITH_SUB) ? A_AND_NOT_B : A_OR_B);
+    blt->bltalwm = -1;
+
+    while (--n >= 0) {
+      void *bptr = (*dst++) + dst_begin;
+
+      blt = BlitterBegin();
+      blt->bltapt = bptr;
+      blt->bltbpt = carry;
+      blt->bltdpt = bptr;
+      BlitterStart(blt, bltsize);
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#include <blitter.h>
+
+/* Computes `dst = (dst + src) / 2` without losing carry out of the most
+ * significant bitplane. Sum bits are written one bitplane lower straight away,
+ * hence the only scratch space needed is the first plane of `carry` bitmap. */
+void BitmapAverage(const BitmapT *dst_bm, const BitmapT *src_bm,
+                   const BitmapT *carry_bm)
+{
+  void *carry = carry_bm->planes[0];
+  void *const *src = src_bm->planes;
+  void *const *dst = dst_bm->planes;
+  u_short bltsize = (dst_bm->height << 6) | (dst_bm->bytesPerRow >> 1);
+  u_short dst_modulo = BitmapStride(dst_bm) - dst_bm->bytesPerRow;
+  u_short carry_modulo = BitmapStride(carry_bm) - dst_bm->bytesPerRow;
+  short n = dst_bm->depth - 1;
+  volatile struct Custom *blt;
+
+  blt = BlitterBegin();
+  blt->bltamod = BitmapStride(src_bm) - dst_bm->bytesPerRow;
+  blt->bltbmod = dst_modulo;
+  blt->bltcmod = carry_modulo;
+  blt->bltcon1 = 0;
+  blt->bltafwm = -1;
+  blt->bltalwm = -1;
+
+  /* Bitplane 0: sum bit is shifted out, only carry is retained. */
+  blt->bltapt = *src++;
+  blt->bltbpt = *dst;
+  blt->bltdpt = (n > 0) ? carry : *dst;
+  blt->bltdmod = (n > 0) ? carry_modulo : dst_modulo;
+  blt->bltcon0 = HALF_ADDER_CARRY;
+  BlitterStart(blt, bltsize);
+
+  /* Bitplane 1-n: full adder, sum goes to preceding bitplane. */
+  while (--n >= 0) {
+    void *aptr = *src++;
+    void *bptr = dst[1];
+
+    blt = BlitterBegin();
+    blt->bltapt = aptr;
+    blt->bltbpt = bptr;
+    blt->bltcpt = carry;
+    blt->bltdpt = *dst++;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = FULL_ADDER;
+    BlitterStart(blt, bltsize);
+
+    /* Carry out of the last bitplane becomes the most significant bit. */
+    blt = BlitterBegin();
+    blt->bltapt = aptr;
+    blt->bltbpt = bptr;
+    blt->bltcpt = carry;
+    blt->bltdpt = (n > 0) ? carry : bptr;
+    blt->bltdmod = (n > 0) ? carry_modulo : dst_modulo;
+    blt->bltcon0 = FULL_ADDER_CARRY;
+    BlitterStart(blt, bltsize);
+  }
+}
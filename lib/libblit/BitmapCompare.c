@@ -0,0 +1,44 @@
+#include <blitter.h>
+
+/* Bit-sliced comparator. Sets pixels in first plane of `lt` bitmap where
+ * value stored in `a` is less than value stored in `b`. That is the borrow out
+ * of `a - b`, which is propagated in place starting from least significant
+ * bitplane. */
+void BitmapCompare(const BitmapT *lt_bm, const BitmapT *a_bm,
+                   const BitmapT *b_bm)
+{
+  void *lt = lt_bm->planes[0];
+  void *const *a = a_bm->planes;
+  void *const *b = b_bm->planes;
+  u_short bltsize = (a_bm->height << 6) | (a_bm->bytesPerRow >> 1);
+  short n = a_bm->depth - 1;
+  volatile struct Custom *blt;
+
+  blt = BlitterBegin();
+  blt->bltamod = BitmapStride(b_bm) - a_bm->bytesPerRow;
+  blt->bltbmod = BitmapStride(a_bm) - a_bm->bytesPerRow;
+  blt->bltcmod = BitmapStride(lt_bm) - a_bm->bytesPerRow;
+  blt->bltdmod = BitmapStride(lt_bm) - a_bm->bytesPerRow;
+  blt->bltcon1 = 0;
+  blt->bltafwm = -1;
+  blt->bltalwm = -1;
+
+  /* Bitplane 0: borrow where `a` bit is zero and `b` bit is one. */
+  blt->bltapt = *b++;
+  blt->bltbpt = *a++;
+  blt->bltdpt = lt;
+  blt->bltcon0 = (SRCA | SRCB | DEST) | A_AND_NOT_B;
+  BlitterStart(blt, bltsize);
+
+  /* Bitplane 1-n: borrow is majority of `b` bit, negated `a` bit and
+   * previous borrow. */
+  while (--n >= 0) {
+    blt = BlitterBegin();
+    blt->bltapt = *b++;
+    blt->bltbpt = *a++;
+    blt->bltcpt = lt;
+    blt->bltdpt = lt;
+    blt->bltcon0 = ADD_CARRY;
+    BlitterStart(blt, bltsize);
+  }
+}
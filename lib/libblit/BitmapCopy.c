@@ -3,6 +3,17 @@
 void BitmapCopy(const BitmapT *dst, u_short x, u_short y, const BitmapT *src) {
   short i, n = min(dst->depth, src->depth);
 
+  /* Interleaved bitmaps are copied with one blit. */
+  if (BitmapFlattenable(dst, src)) {
+    BitmapT _dst, _src;
+
+    BitmapFlatten(&_dst, dst);
+    BitmapFlatten(&_src, src);
+    BlitterCopySetup(&_dst, x, y * dst->depth, &_src);
+    BlitterCopyStart(0, 0);
+    return;
+  }
+
   BlitterCopySetup(dst, x, y, src);
   for (i = 0; i < n; i++)
     BlitterCopyStart(i, i);
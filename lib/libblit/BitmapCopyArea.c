@@ -5,6 +5,19 @@ void BitmapCopyArea(const BitmapT *dst, u_short x, u_short y,
 {
   short i, n = min(dst->depth, src->depth);
 
+  /* Interleaved bitmaps are copied with one blit. */
+  if (BitmapFlattenable(dst, src)) {
+    short depth = dst->depth;
+    Area2D _area = { area->x, area->y * depth, area->w, area->h * depth };
+    BitmapT _dst, _src;
+
+    BitmapFlatten(&_dst, dst);
+    BitmapFlatten(&_src, src);
+    BlitterCopyAreaSetup(&_dst, x, y * depth, &_src, &_area);
+    BlitterCopyAreaStart(0, 0);
+    return;
+  }
+
   BlitterCopyAreaSetup(dst, x, y, src, area);
   for (i = 0; i < n; i++)
     BlitterCopyAreaStart(i, i);
@@ -5,6 +5,17 @@ void BitmapCopyFast(const BitmapT *dst, u_short x, u_short y,
 {
   short i, n = min(dst->depth, src->depth);
 
+  /* Interleaved bitmaps are copied with one blit. */
+  if (BitmapFlattenable(dst, src)) {
+    BitmapT _dst, _src;
+
+    BitmapFlatten(&_dst, dst);
+    BitmapFlatten(&_src, src);
+    BlitterCopyFastSetup(&_dst, x, y * dst->depth, &_src);
+    BlitterCopyFastStart(0, 0);
+    return;
+  }
+
   BlitterCopyFastSetup(dst, x, y, src);
   for (i = 0; i < n; i++)
     BlitterCopyFastStart(i, i);
@@ -5,6 +5,19 @@ void BitmapCopyMasked(const BitmapT *dst, u_short x, u_short y,
 {
   short i, n = min(dst->depth, src->depth);
 
+  /* Interleaved bitmaps are copied with one blit, but the mask must be
+   * interleaved as well and have each of its bitplanes the same. */
+  if (BitmapFlattenable(dst, src) && BitmapFlattenable(src, msk)) {
+    BitmapT _dst, _src, _msk;
+
+    BitmapFlatten(&_dst, dst);
+    BitmapFlatten(&_src, src);
+    BitmapFlatten(&_msk, msk);
+    BlitterCopyMaskedSetup(&_dst, x, y * dst->depth, &_src, &_msk);
+    BlitterCopyMaskedStart(0, 0);
+    return;
+  }
+
   BlitterCopyMaskedSetup(dst, x, y, src, msk);
   for (i = 0; i < n; i++)
     BlitterCopyMaskedStart(i, i);
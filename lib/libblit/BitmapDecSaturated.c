@@ -1,64 +1,86 @@
 #include <blitter.h>
 
-/* Bitplane decrementer with saturation. */
-void BitmapDecSaturated(const BitmapT *dst_bm, const BitmapT *borrow_bm) {
-  void *borrow0 = borrow_bm->planes[0];
-  void *borrow1 = borrow_bm->planes[1];
+/* Bitplane decrementer with saturation. Computes `dst = src - 1` using first
+ * plane of `borrow` bitmap as scratch. Destination may be the same bitmap as
+ * source. */
+void BitmapDecSaturated(const BitmapT *dst_bm, const BitmapT *src_bm,
+                        const BitmapT *borrow_bm)
+{
+  void *borrow = borrow_bm->planes[0];
+  void *const *src = src_bm->planes;
   void *const *dst = dst_bm->planes;
-  void *ptr = *dst++;
   u_short bltsize = (dst_bm->height << 6) | (dst_bm->bytesPerRow >> 1);
+  u_short dst_modulo = BitmapStride(dst_bm) - dst_bm->bytesPerRow;
+  u_short src_modulo = BitmapStride(src_bm) - dst_bm->bytesPerRow;
+  u_short borrow_modulo = BitmapStride(borrow_bm) - dst_bm->bytesPerRow;
   short n = dst_bm->depth - 1;
+  volatile struct Custom *blt;
 
-  WaitBlitter();
-  custom->bltcon1 = 0;
-  custom->bltamod = 0;
-  custom->bltbdat = -1;
-  custom->bltbmod = 0;
-  custom->bltdmod = 0;
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
+  /* Bitplane 0: borrow where the bit was zero - compute it before source
+   * bitplane gets overwritten in case the operation is done in place. */
+  {
+    void *aptr = *src++;
 
-  custom->bltapt = ptr;
-  custom->bltdpt = borrow0;
-  custom->bltcon0 = HALF_SUB_BORROW & ~SRCB;
-  custom->bltsize = bltsize;
+    blt = BlitterBegin();
+    blt->bltcon1 = 0;
+    blt->bltamod = src_modulo;
+    blt->bltbmod = borrow_modulo;
+    blt->bltafwm = -1;
+    blt->bltalwm = -1;
 
-  WaitBlitter();
-  custom->bltapt = ptr;
-  custom->bltdpt = ptr;
-  custom->bltcon0 = HALF_SUB & ~SRCB;
-  custom->bltsize = bltsize;
+    blt->bltapt = aptr;
+    blt->bltdpt = borrow;
+    blt->bltdmod = borrow_modulo;
+    blt->bltcon0 = (SRCA | DEST) | (NABC | NABNC | NANBC | NANBNC);
+    BlitterStart(blt, bltsize);
 
-  while (--n >= 0) {
-    ptr = *dst++;
+    blt = BlitterBegin();
+    blt->bltapt = aptr;
+    blt->bltdpt = *dst++;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = (SRCA | DEST) | (NABC | NABNC | NANBC | NANBNC);
+    BlitterStart(blt, bltsize);
+  }
 
-    WaitBlitter();
-    custom->bltapt = ptr;
-    custom->bltbpt = borrow0;
-    custom->bltdpt = borrow1;
-    custom->bltcon0 = HALF_SUB_BORROW;
-    custom->bltsize = bltsize;
+  while (--n >= 0) {
+    void *ptr = *dst++;
 
-    WaitBlitter();
-    custom->bltapt = ptr;
-    custom->bltbpt = borrow0;
-    custom->bltdpt = ptr;
-    custom->bltcon0 = HALF_SUB;
-    custom->bltsize = bltsize;
+    blt = BlitterBegin();
+    blt->bltapt = *src++;
+    blt->bltamod = src_modulo;
+    blt->bltbpt = borrow;
+    blt->bltdpt = ptr;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = HALF_SUB;
+    BlitterStart(blt, bltsize);
 
-    swapr(borrow0, borrow1);
+    /* Source bit was zero iff new bit is one where borrow was set. */
+    blt = BlitterBegin();
+    blt->bltapt = ptr;
+    blt->bltamod = dst_modulo;
+    blt->bltbpt = borrow;
+    blt->bltdpt = borrow;
+    blt->bltdmod = borrow_modulo;
+    blt->bltcon0 = (SRCA | SRCB | DEST) | A_AND_B;
+    BlitterStart(blt, bltsize);
   }
 
+  /* Apply saturation bits. */
   dst = dst_bm->planes;
   n = dst_bm->depth;
+
+  blt = BlitterBegin();
+  blt->bltamod = dst_modulo;
+  blt->bltdmod = dst_modulo;
+
   while (--n >= 0) {
-    ptr = *dst++;
+    void *ptr = *dst++;
 
-    WaitBlitter();
-    custom->bltapt = ptr;
-    custom->bltbpt = borrow0;
-    custom->bltdpt = ptr;
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_AND_NOT_B;
-    custom->bltsize = bltsize;
+    blt = BlitterBegin();
+    blt->bltapt = ptr;
+    blt->bltbpt = borrow;
+    blt->bltdpt = ptr;
+    blt->bltcon0 = (SRCA | SRCB | DEST) | A_AND_NOT_B;
+    BlitterStart(blt, bltsize);
   }
 }
@@ -1,54 +1,66 @@
 #include <blitter.h>
 
-/* Bitplane incrementer with saturation. */
-void BitmapIncSaturated(const BitmapT *dst_bm, const BitmapT *carry_bm) {
-  void *carry0 = carry_bm->planes[0];
-  void *carry1 = carry_bm->planes[1];
+/* Bitplane incrementer with saturation. Computes `dst = src + 1` for pixels
+ * set to one in first plane of `carry` bitmap, which gets destroyed.
+ * Destination may be the same bitmap as source. */
+void BitmapIncSaturated(const BitmapT *dst_bm, const BitmapT *src_bm,
+                        const BitmapT *carry_bm)
+{
+  void *carry = carry_bm->planes[0];
+  void *const *src = src_bm->planes;
   void *const *dst = dst_bm->planes;
-  void *ptr;
   u_short bltsize = (dst_bm->height << 6) | (dst_bm->bytesPerRow >> 1);
+  u_short dst_modulo = BitmapStride(dst_bm) - dst_bm->bytesPerRow;
+  u_short src_modulo = BitmapStride(src_bm) - dst_bm->bytesPerRow;
+  u_short carry_modulo = BitmapStride(carry_bm) - dst_bm->bytesPerRow;
   short n = dst_bm->depth;
+  volatile struct Custom *blt;
 
-  /* Only pixels set to one in carry[0] will be incremented. */
-  
-  WaitBlitter();
-  custom->bltcon1 = 0;
-  custom->bltamod = 0;
-  custom->bltbmod = 0;
-  custom->bltdmod = 0;
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
+  blt = BlitterBegin();
+  blt->bltcon1 = 0;
+  blt->bltbmod = carry_modulo;
+  blt->bltafwm = -1;
+  blt->bltalwm = -1;
 
   while (--n >= 0) {
-    ptr = *dst++;
-
-    WaitBlitter();
-    custom->bltapt = ptr;
-    custom->bltbpt = carry0;
-    custom->bltdpt = carry1;
-    custom->bltcon0 = HALF_ADDER_CARRY;
-    custom->bltsize = bltsize;
-
-    WaitBlitter();
-    custom->bltapt = ptr;
-    custom->bltbpt = carry0;
-    custom->bltdpt = ptr;
-    custom->bltcon0 = HALF_ADDER;
-    custom->bltsize = bltsize;
-
-    swapr(carry0, carry1);
+    void *ptr = *dst++;
+
+    blt = BlitterBegin();
+    blt->bltapt = *src++;
+    blt->bltamod = src_modulo;
+    blt->bltbpt = carry;
+    blt->bltdpt = ptr;
+    blt->bltdmod = dst_modulo;
+    blt->bltcon0 = HALF_ADDER;
+    BlitterStart(blt, bltsize);
+
+    /* Source bit was one iff new bit is zero where carry was set. */
+    blt = BlitterBegin();
+    blt->bltapt = ptr;
+    blt->bltamod = dst_modulo;
+    blt->bltbpt = carry;
+    blt->bltdpt = carry;
+    blt->bltdmod = carry_modulo;
+    blt->bltcon0 = (SRCA | SRCB | DEST) | (NABC | NABNC);
+    BlitterStart(blt, bltsize);
   }
 
+  /* Apply saturation bits. */
   dst = dst_bm->planes;
   n = dst_bm->depth;
+
+  blt = BlitterBegin();
+  blt->bltamod = dst_modulo;
+  blt->bltdmod = dst_modulo;
+
   while (--n >= 0) {
-    ptr = *dst++;
-
-    WaitBlitter();
-    custom->bltapt = ptr;
-    custom->bltbpt = carry0;
-    custom->bltdpt = ptr;
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
-    custom->bltsize = bltsize;
+    void *ptr = *dst++;
+
+    blt = BlitterBegin();
+    blt->bltapt = ptr;
+    blt->bltbpt = carry;
+    blt->bltdpt = ptr;
+    blt->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
+    BlitterStart(blt, bltsize);
   }
 }
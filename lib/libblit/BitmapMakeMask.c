@@ -1,29 +1,50 @@
 #include <blitter.h>
 
+/* Mask of interleaved bitmap is interleaved as well and has all bitplanes set
+ * to the same data, so that BitmapCopyMasked can use it with a single blit. */
 BitmapT *BitmapMakeMask(const BitmapT *bitmap) {
-  BitmapT *mask = NewBitmap(bitmap->width, bitmap->height, 1);
+  bool interleaved = bitmap->flags & BM_INTERLEAVED;
+  BitmapT *mask = NewBitmapCustom(bitmap->width, bitmap->height,
+                                  interleaved ? bitmap->depth : 1,
+                                  BM_CLEAR | BM_DISPLAYABLE |
+                                  (interleaved ? BM_INTERLEAVED : 0));
   u_short bltsize = (bitmap->height << 6) | (bitmap->bytesPerRow >> 1);
-  void **planes = bitmap->planes;
+  u_short srcmod = BitmapStride(bitmap) - bitmap->bytesPerRow;
+  u_short dstmod = BitmapStride(mask) - mask->bytesPerRow;
+  void *const *planes = bitmap->planes;
   void *dst = mask->planes[0];
   short n = bitmap->depth;
+  volatile struct Custom *blt;
 
   while (--n >= 0) {
     void *src = *planes++;
 
-    WaitBlitter();
+    blt = BlitterBegin();
 
-    custom->bltamod = 0;
-    custom->bltbmod = 0;
-    custom->bltdmod = 0;
-    custom->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
-    custom->bltcon1 = 0;
-    custom->bltafwm = -1;
-    custom->bltalwm = -1;
+    blt->bltamod = srcmod;
+    blt->bltbmod = dstmod;
+    blt->bltdmod = dstmod;
+    blt->bltcon0 = (SRCA | SRCB | DEST) | A_OR_B;
+    blt->bltcon1 = 0;
+    blt->bltafwm = -1;
+    blt->bltalwm = -1;
 
-    custom->bltapt = src;
-    custom->bltbpt = dst;
-    custom->bltdpt = dst;
-    custom->bltsize = bltsize;
+    blt->bltapt = src;
+    blt->bltbpt = dst;
+    blt->bltdpt = dst;
+    BlitterStart(blt, bltsize);
+  }
+
+  for (n = 1; n < mask->depth; n++) {
+    blt = BlitterBegin();
+
+    blt->bltamod = dstmod;
+    blt->bltdmod = dstmod;
+    blt->bltcon0 = (SRCA | DEST) | A_TO_D;
+
+    blt->bltapt = dst;
+    blt->bltdpt = mask->planes[n];
+    BlitterStart(blt, bltsize);
   }
 
   return mask;
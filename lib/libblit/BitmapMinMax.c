@@ -0,0 +1,38 @@
+#include <blitter.h>
+
+/* Computes per pixel minimum (or maximum) of `dst` and `src` and stores it in
+ * `dst`. Pixels where `dst` is less than `src` are marked in first plane of
+ * `scratch` bitmap, which is then used to select bits from either operand. */
+void _BitmapMinMax(const BitmapT *dst_bm, const BitmapT *src_bm,
+                   const BitmapT *scratch_bm, bool max)
+{
+  void *mask = scratch_bm->planes[0];
+  void *const *src = src_bm->planes;
+  void *const *dst = dst_bm->planes;
+  u_short bltsize = (dst_bm->height << 6) | (dst_bm->bytesPerRow >> 1);
+  short n = dst_bm->depth;
+  volatile struct Custom *blt;
+
+  BitmapCompare(scratch_bm, dst_bm, src_bm);
+
+  blt = BlitterBegin();
+  blt->bltamod = BitmapStride(src_bm) - dst_bm->bytesPerRow;
+  blt->bltbmod = BitmapStride(dst_bm) - dst_bm->bytesPerRow;
+  blt->bltcmod = BitmapStride(scratch_bm) - dst_bm->bytesPerRow;
+  blt->bltdmod = BitmapStride(dst_bm) - dst_bm->bytesPerRow;
+
+  /* A: source, B: destination, C: mask */
+  blt->bltcon0 = (SRCA | SRCB | SRCC | DEST) |
+    (max ? (ABC | ANBC | ABNC | NABNC) : (ABC | NABC | ABNC | ANBNC));
+
+  while (--n >= 0) {
+    void *ptr = *dst++;
+
+    blt = BlitterBegin();
+    blt->bltapt = *src++;
+    blt->bltbpt = ptr;
+    blt->bltcpt = mask;
+    blt->bltdpt = ptr;
+    BlitterStart(blt, bltsize);
+  }
+}
@@ -1,8 +1,29 @@
 #include <blitter.h>
 
 void BitmapSetArea(const BitmapT *bitmap, const Area2D *area, u_short color) {
+  u_short all = (1 << bitmap->depth) - 1;
   short i;
 
+  /* All bitplanes of interleaved bitmap can be set with one blit, as long as
+   * they're filled with the same pattern. */
+  if (BitmapFlattenable(bitmap, bitmap) &&
+      ((color & all) == 0 || (color & all) == all)) {
+    short depth = bitmap->depth;
+    BitmapT _bitmap;
+    Area2D _area;
+
+    BitmapFlatten(&_bitmap, bitmap);
+    if (area) {
+      _area.x = area->x;
+      _area.y = area->y * depth;
+      _area.w = area->w;
+      _area.h = area->h * depth;
+    }
+    BlitterSetAreaSetup(&_bitmap, area ? &_area : NULL);
+    BlitterSetAreaStart(0, (color & all) ? -1 : 0);
+    return;
+  }
+
   BlitterSetAreaSetup(bitmap, area);
   for (i = 0; i < bitmap->depth; i++) {
     BlitterSetAreaStart(i, (color & (1 << i)) ? -1 : 0);
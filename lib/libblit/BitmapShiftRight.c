@@ -0,0 +1,32 @@
+#include <blitter.h>
+
+/* Divides values stored in bitmap by two, i.e. moves each bitplane one
+ * position down and clears the most significant one. */
+void BitmapShiftRight(const BitmapT *bm) {
+  void *const *planes = bm->planes;
+  u_short bltsize = (bm->height << 6) | (bm->bytesPerRow >> 1);
+  u_short bltmod = BitmapStride(bm) - bm->bytesPerRow;
+  short n = bm->depth - 1;
+  volatile struct Custom *blt;
+
+  blt = BlitterBegin();
+  blt->bltamod = bltmod;
+  blt->bltdmod = bltmod;
+  blt->bltcon0 = (SRCA | DEST) | A_TO_D;
+  blt->bltcon1 = 0;
+  blt->bltafwm = -1;
+  blt->bltalwm = -1;
+
+  for (; n > 0; n--, planes++) {
+    blt = BlitterBegin();
+    blt->bltapt = planes[1];
+    blt->bltdpt = planes[0];
+    BlitterStart(blt, bltsize);
+  }
+
+  blt = BlitterBegin();
+  blt->bltadat = 0;
+  blt->bltdpt = planes[0];
+  blt->bltcon0 = DEST | A_TO_D;
+  BlitterStart(blt, bltsize);
+}
@@ -16,45 +16,47 @@ void BlitterCopySetup(const BitmapT *dst, u_short x, u_short y,
   /* Calculate real blit width. It can be greater than src->bytesPerRow! */
   u_short width = (x & 15) + src->width;
   u_short bytesPerRow = ((width + 15) & ~15) >> 3;
-  u_short srcmod = src->bytesPerRow - bytesPerRow;
-  u_short dstmod = dst->bytesPerRow - bytesPerRow;
+  u_short srcmod = BitmapStride(src) - bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - bytesPerRow;
   u_short bltafwm = FirstWordMask[x & 15];
   u_short bltalwm = LastWordMask[width & 15];
   u_short bltshift = rorw(x & 15, 4);
+  volatile struct Custom *blt;
 
   state->src = src;
   state->dst = dst;
-  state->start = ((x & ~15) >> 3) + y * dst->bytesPerRow;
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(dst);
   state->size = (src->height << 6) | (bytesPerRow >> 1);
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
   if (bltshift) {
-    custom->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
-    custom->bltbmod = srcmod;
-    custom->bltadat = -1;
-    custom->bltcmod = dstmod;
+    blt->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
+    blt->bltbmod = srcmod;
+    blt->bltadat = -1;
+    blt->bltcmod = dstmod;
   } else {
-    custom->bltamod = 0;
-    custom->bltcon0 = (SRCA | DEST) | A_TO_D;
+    blt->bltamod = srcmod;
+    blt->bltcon0 = (SRCA | DEST) | A_TO_D;
   }
 
-  custom->bltcon1 = bltshift;
-  custom->bltafwm = bltafwm;
-  custom->bltalwm = bltalwm;
-  custom->bltdmod = dstmod;
+  blt->bltcon1 = bltshift;
+  blt->bltafwm = bltafwm;
+  blt->bltalwm = bltalwm;
+  blt->bltdmod = dstmod;
 }
 
 void BlitterCopyStart(short dstbpl, short srcbpl) {
   void *srcbpt = state->src->planes[srcbpl];
   void *dstbpt = state->dst->planes[dstbpl] + state->start;
   u_short bltsize = state->size;
+  volatile struct Custom *blt;
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  custom->bltapt = srcbpt;
-  custom->bltbpt = srcbpt;
-  custom->bltcpt = dstbpt;
-  custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  blt->bltapt = srcbpt;
+  blt->bltbpt = srcbpt;
+  blt->bltcpt = dstbpt;
+  blt->bltdpt = dstbpt;
+  BlitterStart(blt, bltsize);
 }
@@ -33,11 +33,14 @@ void BlitterCopyAreaSetup(const BitmapT *dst, u_short dx, u_short dy,
   u_short width = xo + sw;
   u_short wo = width & 15;
   u_short bytesPerRow = ALIGN(width);
-  u_short srcmod = src->bytesPerRow - bytesPerRow;
-  u_short dstmod = dst->bytesPerRow - bytesPerRow;
+  u_short srcstride = BitmapStride(src);
+  u_short dststride = BitmapStride(dst);
+  u_short srcmod = srcstride - bytesPerRow;
+  u_short dstmod = dststride - bytesPerRow;
   u_short bltafwm = FirstWordMask[dxo];
   u_short bltalwm = LastWordMask[wo];
   u_short bltshift = rorw(xo, 4);
+  volatile struct Custom *blt;
 
   /*
    * TODO: Two cases exist where number of word for 'src' and 'dst' differ.
@@ -54,40 +57,40 @@ void BlitterCopyAreaSetup(const BitmapT *dst, u_short dx, u_short dy,
   state->size = (sh << 6) | (bytesPerRow >> 1);
 
   if (forward) {
-    state->src_start += (short)sy * (short)src->bytesPerRow;
-    state->dst_start += (short)dy * (short)dst->bytesPerRow;
+    state->src_start += (short)sy * (short)srcstride;
+    state->dst_start += (short)dy * (short)dststride;
   } else {
-    state->src_start += (short)(sy + sh - 1) * (short)src->bytesPerRow
+    state->src_start += (short)(sy + sh - 1) * (short)srcstride
                       + bytesPerRow - 2;
-    state->dst_start += (short)(dy + sh - 1) * (short)dst->bytesPerRow
+    state->dst_start += (short)(dy + sh - 1) * (short)dststride
                       + bytesPerRow - 2;
   }
 
   state->fast = (xo == 0) && (wo == 0);
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
   if (!state->fast) {
-    custom->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
-    custom->bltcon1 = bltshift | (forward ? 0 : BLITREVERSE);
-    custom->bltadat = -1;
+    blt->bltcon0 = (SRCB | SRCC | DEST) | (ABC | NABC | ABNC | NANBC);
+    blt->bltcon1 = bltshift | (forward ? 0 : BLITREVERSE);
+    blt->bltadat = -1;
     if (forward) {
-      custom->bltafwm = bltafwm;
-      custom->bltalwm = bltalwm;
+      blt->bltafwm = bltafwm;
+      blt->bltalwm = bltalwm;
     } else {
-      custom->bltafwm = bltalwm;
-      custom->bltalwm = bltafwm;
+      blt->bltafwm = bltalwm;
+      blt->bltalwm = bltafwm;
     }
-    custom->bltbmod = srcmod;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
+    blt->bltbmod = srcmod;
+    blt->bltcmod = dstmod;
+    blt->bltdmod = dstmod;
   } else {
-    custom->bltcon0 = (SRCA | DEST) | A_TO_D;
-    custom->bltcon1 = 0;
-    custom->bltafwm = -1;
-    custom->bltalwm = -1;
-    custom->bltamod = srcmod;
-    custom->bltdmod = dstmod;
+    blt->bltcon0 = (SRCA | DEST) | A_TO_D;
+    blt->bltcon1 = 0;
+    blt->bltafwm = -1;
+    blt->bltalwm = -1;
+    blt->bltamod = srcmod;
+    blt->bltdmod = dstmod;
   }
 }
 
@@ -95,19 +98,20 @@ void BlitterCopyAreaStart(short dstbpl, short srcbpl) {
   void *srcbpt = state->src->planes[srcbpl] + state->src_start;
   void *dstbpt = state->dst->planes[dstbpl] + state->dst_start;
   u_short bltsize = state->size;
+  volatile struct Custom *blt;
 
   if (state->fast) {
-    WaitBlitter();
+    blt = BlitterBegin();
 
-    custom->bltapt = srcbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
+    blt->bltapt = srcbpt;
+    blt->bltdpt = dstbpt;
+    BlitterStart(blt, bltsize);
   } else {
-    WaitBlitter();
+    blt = BlitterBegin();
 
-    custom->bltbpt = srcbpt;
-    custom->bltcpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltsize = bltsize;
+    blt->bltbpt = srcbpt;
+    blt->bltcpt = dstbpt;
+    blt->bltdpt = dstbpt;
+    BlitterStart(blt, bltsize);
   }
 }
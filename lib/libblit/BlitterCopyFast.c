@@ -12,42 +12,39 @@ static StateT state[1];
 void BlitterCopyFastSetup(const BitmapT *dst, u_short x, u_short y,
                           const BitmapT *src) 
 {
-  u_short dstmod = dst->bytesPerRow - src->bytesPerRow;
+  u_short srcmod = BitmapStride(src) - src->bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - src->bytesPerRow;
   u_short bltshift = rorw(x & 15, 4);
   u_short bltsize = (src->height << 6) | (src->bytesPerRow >> 1);
+  volatile struct Custom *blt;
 
   if (bltshift)
-    bltsize++, dstmod -= 2;
+    bltsize++, srcmod -= 2, dstmod -= 2;
 
   state->src = src;
   state->dst = dst;
-  state->start = ((x & ~15) >> 3) + y * dst->bytesPerRow;
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(dst);
   state->size = bltsize;
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  if (bltshift) {
-    custom->bltalwm = 0;
-    custom->bltamod = -2;
-  } else {
-    custom->bltalwm = -1;
-    custom->bltamod = 0;
-  }
-
-  custom->bltdmod = dstmod;
-  custom->bltcon0 = (SRCA | DEST | A_TO_D) | bltshift;
-  custom->bltcon1 = 0;
-  custom->bltafwm = -1;
+  blt->bltalwm = bltshift ? 0 : -1;
+  blt->bltamod = srcmod;
+  blt->bltdmod = dstmod;
+  blt->bltcon0 = (SRCA | DEST | A_TO_D) | bltshift;
+  blt->bltcon1 = 0;
+  blt->bltafwm = -1;
 }
 
 void BlitterCopyFastStart(short dstbpl, short srcbpl) {
   void *srcbpt = state->src->planes[srcbpl];
   void *dstbpt = state->dst->planes[dstbpl] + state->start;
   u_short bltsize = state->size;
+  volatile struct Custom *blt;
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  custom->bltapt = srcbpt;
-  custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  blt->bltapt = srcbpt;
+  blt->bltdpt = dstbpt;
+  BlitterStart(blt, bltsize);
 }
@@ -13,38 +13,43 @@ static StateT state[1];
 void BlitterCopyMaskedSetup(const BitmapT *dst, u_short x, u_short y,
                             const BitmapT *src, const BitmapT *msk)
 {
-  u_short dstmod = dst->bytesPerRow - src->bytesPerRow;
+  u_short srcmod = BitmapStride(src) - src->bytesPerRow;
+  u_short mskmod = BitmapStride(msk) - src->bytesPerRow;
+  u_short dstmod = BitmapStride(dst) - src->bytesPerRow;
   u_short bltsize = (src->height << 6) | (src->bytesPerRow >> 1);
   u_short bltshift = rorw(x & 15, 4);
+  volatile struct Custom *blt;
 
   state->src = src;
   state->dst = dst;
   state->msk = msk;
-  state->start = ((x & ~15) >> 3) + y * dst->bytesPerRow;
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(dst);
 
   if (bltshift)
-    bltsize++, dstmod -= 2;
+    bltsize++, srcmod -= 2, mskmod -= 2, dstmod -= 2;
 
-  WaitBlitter();
+  state->size = bltsize;
+
+  blt = BlitterBegin();
 
   if (bltshift) {
-    custom->bltamod = -2;
-    custom->bltbmod = -2;
-    custom->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC) | bltshift;
-    custom->bltcon1 = bltshift;
-    custom->bltalwm = 0;
-    custom->bltafwm = -1;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
+    blt->bltamod = srcmod;
+    blt->bltbmod = mskmod;
+    blt->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC) | bltshift;
+    blt->bltcon1 = bltshift;
+    blt->bltalwm = 0;
+    blt->bltafwm = -1;
+    blt->bltcmod = dstmod;
+    blt->bltdmod = dstmod;
   } else {
-    custom->bltamod = 0;
-    custom->bltbmod = 0;
-    custom->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC);
-    custom->bltcon1 = 0;
-    custom->bltalwm = -1;
-    custom->bltafwm = -1;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
+    blt->bltamod = srcmod;
+    blt->bltbmod = mskmod;
+    blt->bltcon0 = (SRCA | SRCB | SRCC | DEST) | (ABC | ABNC | ANBC | NANBC);
+    blt->bltcon1 = 0;
+    blt->bltalwm = -1;
+    blt->bltafwm = -1;
+    blt->bltcmod = dstmod;
+    blt->bltdmod = dstmod;
   }
 }
 
@@ -53,12 +58,13 @@ void BlitterCopyMaskedStart(short dstbpl, short srcbpl) {
   void *dstbpt = state->dst->planes[dstbpl] + state->start;
   void *mskbpt = state->msk->planes[0];
   u_short bltsize = state->size;
+  volatile struct Custom *blt;
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  custom->bltapt = srcbpt;
-  custom->bltbpt = mskbpt;
-  custom->bltcpt = dstbpt;
-  custom->bltdpt = dstbpt;
-  custom->bltsize = bltsize;
+  blt->bltapt = srcbpt;
+  blt->bltbpt = mskbpt;
+  blt->bltcpt = dstbpt;
+  blt->bltdpt = dstbpt;
+  BlitterStart(blt, bltsize);
 }
@@ -2,35 +2,38 @@
 
 void BlitterFillArea(const BitmapT *bitmap, short plane, const Area2D *area) {
   void *bltpt = bitmap->planes[plane];
+  u_short stride = BitmapStride(bitmap);
   u_short bltmod, bltsize;
+  volatile struct Custom *blt;
 
   if (area) {
     short x = area->x;
-    short y = area->y; 
+    short y = area->y;
     short w = area->w;
     short h = area->h;
 
-    bltpt += (((x + w) >> 3) & ~1) + (short)(y + h) * (short)bitmap->bytesPerRow;
+    /* Descending mode starts with the last word of the last row. */
+    bltpt += (((x + w) >> 3) & ~1) + (short)(y + h - 1) * (short)stride;
     w >>= 3;
-    bltmod = bitmap->bytesPerRow - w;
+    bltmod = stride - w;
     bltsize = (h << 6) | (w >> 1);
   } else {
-    bltpt += bitmap->bplSize;
-    bltmod = 0;
+    bltpt += (short)(bitmap->height - 1) * (short)stride + bitmap->bytesPerRow;
+    bltmod = stride - bitmap->bytesPerRow;
     bltsize = (bitmap->height << 6) | (bitmap->bytesPerRow >> 1);
   }
 
   bltpt -= 2;
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  custom->bltapt = bltpt;
-  custom->bltdpt = bltpt;
-  custom->bltamod = bltmod;
-  custom->bltdmod = bltmod;
-  custom->bltcon0 = (SRCA | DEST) | A_TO_D;
-  custom->bltcon1 = BLITREVERSE | FILL_OR;
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
-  custom->bltsize = bltsize;
+  blt->bltapt = bltpt;
+  blt->bltdpt = bltpt;
+  blt->bltamod = bltmod;
+  blt->bltdmod = bltmod;
+  blt->bltcon0 = (SRCA | DEST) | A_TO_D;
+  blt->bltcon1 = BLITREVERSE | FILL_OR;
+  blt->bltafwm = -1;
+  blt->bltalwm = -1;
+  BlitterStart(blt, bltsize);
 }
@@ -42,31 +42,96 @@ struct {
   short stride;
   u_short bltcon0;
   u_short bltcon1;
+  bool cpu;
 } line[1];
 
 void BlitterLineSetupFull(const BitmapT *bitmap, u_short plane,
                           u_short mode, u_short pattern)
 {
+  volatile struct Custom *blt;
+
   line->data = bitmap->planes[plane];
   line->scratch = bitmap->planes[bitmap->depth];
-  line->stride = bitmap->bytesPerRow;
+  line->stride = BitmapStride(bitmap);
   line->bltcon0 = LineMode[mode][0];
   line->bltcon1 = LineMode[mode][1];
+  /* CPU can draw short lines only if each pixel is plotted in solid color. */
+  line->cpu = !(mode & LINE_ONEDOT) && (pattern == 0xffff);
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  custom->bltafwm = -1;
-  custom->bltalwm = -1;
-  custom->bltadat = 0x8000;
-  custom->bltbdat = pattern; /* Line texture pattern. */
-  custom->bltcmod = line->stride;
-  custom->bltdmod = line->stride;
+  blt->bltafwm = -1;
+  blt->bltalwm = -1;
+  blt->bltadat = 0x8000;
+  blt->bltbdat = pattern; /* Line texture pattern. */
+  blt->bltcmod = line->stride;
+  blt->bltdmod = line->stride;
 }
 
-void BlitterLine(short x1 asm("d2"), short y1 asm("d3"), short x2 asm("d4"), short y2 asm("d5")) {
+/* Register values that differ between lines. */
+typedef struct {
+  u_short bltcon0;
+  u_short bltcon1;
+  u_short bltamod;
+  u_short bltbmod;
+  short derr;
+  u_short bltsize;
+  void *data;
+} LineRegsT;
+
+/* Octant bits of bltcon1 indexed by (x decreasing) << 1 | (y-major). */
+static const u_short Octant[4] = { SUD, 0, AUL | SUD, SUL };
+
+static inline void LineRegs(LineRegsT *regs, short x1, short y1,
+                            short dx, short dy)
+{
   u_char *data = line->data;
-  u_short bltcon1 = line->bltcon1;
-  short dx, dy, derr;
+  short i = 0;
+  short derr;
+
+  /* Word containing the first pixel of the line. */
+  data += line->stride * y1;
+  data += (x1 >> 3) & ~1;
+
+  if (dx < 0) {
+    dx = -dx;
+    i = 2;
+  }
+
+  if (dx < dy) {
+    swapr(dx, dy);
+    i++;
+  }
+
+  derr = dy + dy - dx;
+
+  regs->bltcon0 = rorw(x1 & 15, 4) | line->bltcon0;
+  regs->bltcon1 = line->bltcon1 | Octant[i] | (derr < 0 ? SIGNFLAG : 0);
+  regs->bltamod = derr - dx;
+  regs->bltbmod = dy + dy;
+  regs->derr = derr;
+  regs->bltsize = (dx << 6) + 66;
+  regs->data = data;
+}
+
+static inline void LineStart(const LineRegsT *regs) {
+  void *data = regs->data;
+  volatile struct Custom *blt;
+
+  blt = BlitterBegin();
+
+  blt->bltcon0 = regs->bltcon0;
+  blt->bltcon1 = regs->bltcon1;
+  blt->bltamod = regs->bltamod;
+  blt->bltbmod = regs->bltbmod;
+  blt->bltapt = (void *)(int)regs->derr;
+  blt->bltcpt = data;
+  blt->bltdpt = (regs->bltcon1 & ONEDOT) ? line->scratch : data;
+  BlitterStart(blt, regs->bltsize);
+}
+
+void BlitterLine(short x1 asm("d2"), short y1 asm("d3"), short x2 asm("d4"), short y2 asm("d5")) {
+  LineRegsT regs;
 
   /* Always draw the line downwards. */
   if (y1 > y2) {
@@ -74,49 +139,109 @@ void BlitterLine(short x1 asm("d2"), short y1 asm("d3"), short x2 asm("d4"), sho
     swapr(y1, y2);
   }
 
-  /* Word containing the first pixel of the line. */
-  data += line->stride * y1;
-  data += (x1 >> 3) & ~1;
-
-  dx = x2 - x1;
-  dy = y2 - y1;
+  LineRegs(&regs, x1, y1, x2 - x1, y2 - y1);
+  LineStart(&regs);
+}
 
-  if (dx < 0) {
+/* Bresenham's algorithm for lines too short to be worth blitter setup. */
+static void CpuLineShort(short x1, short y1, short dx, short dy) {
+  u_char *pixels = line->data + line->stride * y1 + (x1 >> 3);
+  u_char bit = 0x80 >> (x1 & 7);
+  short stride = line->stride;
+  bool eor = line->bltcon0 == BC0F_LINE_EOR;
+  bool left = dx < 0;
+  bool ymajor;
+  short n, derr;
+
+  if (left)
     dx = -dx;
-    if (dx >= dy) {
-      bltcon1 |= AUL | SUD;
-    } else {
-      bltcon1 |= SUL;
-      swapr(dx, dy);
+
+  ymajor = dx < dy;
+  if (ymajor) {
+    swapr(dx, dy);
+  }
+
+  derr = dy + dy - dx;
+
+  for (n = dx; n >= 0; n--) {
+    if (eor)
+      *pixels ^= bit;
+    else
+      *pixels |= bit;
+
+    /* Always step along major axis, along minor one when error overflows. */
+    if (ymajor || derr >= 0)
+      pixels += stride;
+
+    if (!ymajor || derr >= 0) {
+      if (left) {
+        bit <<= 1;
+        if (!bit)
+          bit = 0x01, pixels--;
+      } else {
+        bit >>= 1;
+        if (!bit)
+          bit = 0x80, pixels++;
+      }
+    }
+
+    if (derr >= 0)
+      derr -= dx + dx;
+    derr += dy + dy;
+  }
+}
+
+static inline bool LineShort(short x1, short y1, short x2, short y2) {
+  return abs(x2 - x1) < LINE_CPU_MAX && abs(y2 - y1) < LINE_CPU_MAX;
+}
+
+/* Registers of each line are calculated while the blitter is still drawing
+ * the previous one, as BlitterBegin waits for it only just before they are
+ * written. */
+void BlitterLines(const Line2D *lines, short n) {
+  const Line2D *curr = lines;
+  bool cpu = false;
+  short i;
+
+  for (i = 0; i < n; i++, curr++) {
+    short x1 = curr->x1, y1 = curr->y1, x2 = curr->x2, y2 = curr->y2;
+    LineRegsT regs;
+
+    if (line->cpu && LineShort(x1, y1, x2, y2)) {
+      cpu = true;
+      continue;
     }
-  } else {
-    if (dx >= dy) {
-      bltcon1 |= SUD;
-    } else {
-      swapr(dx, dy);
+
+    /* Always draw the line downwards. */
+    if (y1 > y2) {
+      swapr(x1, x2);
+      swapr(y1, y2);
     }
+
+    LineRegs(&regs, x1, y1, x2 - x1, y2 - y1);
+    LineStart(&regs);
   }
 
-  derr = dy + dy - dx;
-  if (derr < 0)
-    bltcon1 |= SIGNFLAG;
-
-  {
-    u_short bltcon0 = rorw(x1 & 15, 4) | line->bltcon0;
-    u_short bltamod = derr - dx;
-    u_short bltbmod = dy + dy;
-    void *bltdpt = (bltcon1 & ONEDOT) ? line->scratch : data;
-    u_short bltsize = (dx << 6) + 66;
-
-    WaitBlitter();
-
-    custom->bltcon0 = bltcon0;
-    custom->bltcon1 = bltcon1;
-    custom->bltamod = bltamod;
-    custom->bltbmod = bltbmod;
-    custom->bltapt = (void *)(int)derr;
-    custom->bltcpt = data;
-    custom->bltdpt = bltdpt;
-    custom->bltsize = bltsize;
+  if (!cpu)
+    return;
+
+  /* Blitter must not be drawing lines while CPU modifies the same bitplane,
+   * as pixels plotted by CPU could be lost in read-modify-write cycle. Both
+   * OR and EOR modes give the same result regardless of drawing order, so
+   * short lines are deferred until all long ones are started. */
+  BlitterSync();
+
+  for (i = 0, curr = lines; i < n; i++, curr++) {
+    short x1 = curr->x1, y1 = curr->y1, x2 = curr->x2, y2 = curr->y2;
+
+    if (!LineShort(x1, y1, x2, y2))
+      continue;
+
+    if (y1 > y2) {
+      swapr(x1, x2);
+      swapr(y1, y2);
+    }
+
+    CpuLineShort(x1, y1, x2 - x1, y2 - y1);
   }
 }
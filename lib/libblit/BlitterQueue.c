@@ -0,0 +1,111 @@
+#include <blitter.h>
+#include <debug.h>
+#include <system/interrupt.h>
+
+/* Same layout as blitter registers in struct Custom. */
+typedef struct BlitJob {
+  u_short bltcon0, bltcon1;
+  u_short bltafwm, bltalwm;
+  void *bltcpt, *bltbpt, *bltapt, *bltdpt;
+  u_short bltsize;
+  u_short _pad0[3];
+  u_short bltcmod, bltbmod, bltamod, bltdmod;
+  u_short _pad1[4];
+  u_short bltcdat, bltbdat, bltadat;
+} BlitJobT;
+
+volatile struct Custom *_BlitterQueue = NULL;
+
+static BlitJobT Shadow;
+static BlitJobT Queue[BLITQ_SIZE];
+static volatile u_short Head, Tail;
+static volatile bool Busy;
+
+static void StartJob(BlitJobT *job) {
+  custom->bltcon0 = job->bltcon0;
+  custom->bltcon1 = job->bltcon1;
+  custom->bltafwm = job->bltafwm;
+  custom->bltalwm = job->bltalwm;
+  custom->bltcpt = job->bltcpt;
+  custom->bltbpt = job->bltbpt;
+  custom->bltapt = job->bltapt;
+  custom->bltdpt = job->bltdpt;
+  custom->bltcmod = job->bltcmod;
+  custom->bltbmod = job->bltbmod;
+  custom->bltamod = job->bltamod;
+  custom->bltdmod = job->bltdmod;
+  custom->bltcdat = job->bltcdat;
+  custom->bltbdat = job->bltbdat;
+  custom->bltadat = job->bltadat;
+  custom->bltsize = job->bltsize;
+}
+
+/* Called from blitter interrupt, or with blitter interrupt disabled. */
+static void StartNextJob(void) {
+  u_short head = Head;
+
+  if (head == Tail) {
+    Busy = false;
+    return;
+  }
+
+  StartJob(&Queue[head]);
+  Head = (head + 1) & (BLITQ_SIZE - 1);
+}
+
+void _BlitterQueueStart(u_short bltsize) {
+  u_short tail = Tail;
+  u_short next = (tail + 1) & (BLITQ_SIZE - 1);
+
+  /* Queue is full - wait for the interrupt handler to start a blit. */
+  while (next == Head)
+    continue;
+
+  Shadow.bltsize = bltsize;
+  Queue[tail] = Shadow;
+
+  DisableINT(INTF_BLIT);
+  Tail = next;
+  if (!Busy) {
+    Busy = true;
+    /* Blitter might have been started directly before, so make sure its
+     * completion does not trigger the handler once the job is running. */
+    WaitBlitter();
+    ClearIRQ(INTF_BLIT);
+    StartNextJob();
+  }
+  EnableINT(INTF_BLIT);
+}
+
+void BlitterSync(void) {
+  while (Busy)
+    continue;
+  WaitBlitter();
+}
+
+void BlitterQueueInit(void) {
+  /* Someone else (e.g. C2PStep driven effect) owns the blitter interrupt. */
+  if (custom->intenar & INTF_BLIT)
+    Panic("[BlitterQueue] Blitter interrupt is already in use!\n");
+
+  WaitBlitter();
+
+  Head = Tail = 0;
+  Busy = false;
+  _BlitterQueue = (volatile struct Custom *)
+    ((u_char *)&Shadow - offsetof(struct Custom, bltcon0));
+
+  SetIntVector(INTB_BLIT, (IntHandlerT)StartNextJob, NULL);
+  ClearIRQ(INTF_BLIT);
+  EnableINT(INTF_BLIT);
+}
+
+void BlitterQueueKill(void) {
+  BlitterSync();
+
+  DisableINT(INTF_BLIT);
+  ClearIRQ(INTF_BLIT);
+  ResetIntVector(INTB_BLIT);
+
+  _BlitterQueue = NULL;
+}
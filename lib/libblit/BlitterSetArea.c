@@ -13,6 +13,7 @@ static StateT state[1];
 void BlitterSetAreaSetup(const BitmapT *bitmap, const Area2D *area) {
   u_short bltafwm, bltalwm, bltmod, bytesPerRow;
   u_short x = 0, y = 0, width = bitmap->width, height = bitmap->height;
+  volatile struct Custom *blt;
 
   if (area)
     x = area->x, y = area->y, width = area->w, height = area->h;
@@ -22,36 +23,37 @@ void BlitterSetAreaSetup(const BitmapT *bitmap, const Area2D *area) {
 
   bltafwm = FirstWordMask[x & 15];
   bltalwm = LastWordMask[width & 15];
-  bltmod = bitmap->bytesPerRow - bytesPerRow;
+  bltmod = BitmapStride(bitmap) - bytesPerRow;
 
   state->bitmap = bitmap;
-  state->start = ((x & ~15) >> 3) + y * bitmap->bytesPerRow;
+  state->start = ((x & ~15) >> 3) + y * BitmapStride(bitmap);
   state->size = (height << 6) | (bytesPerRow >> 1);
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
   if ((x & 15) || (width & 15)) {
-    custom->bltadat = -1;
-    custom->bltbmod = bltmod;
-    custom->bltcon0 = (SRCB | DEST) | (NABC | NABNC | ABC | ANBC);
+    blt->bltadat = -1;
+    blt->bltbmod = bltmod;
+    blt->bltcon0 = (SRCB | DEST) | (NABC | NABNC | ABC | ANBC);
   } else {
-    custom->bltcon0 = DEST | C_TO_D;
+    blt->bltcon0 = DEST | C_TO_D;
   }
 
-  custom->bltcon1 = 0;
-  custom->bltdmod = bltmod;
-  custom->bltafwm = bltafwm;
-  custom->bltalwm = bltalwm;
+  blt->bltcon1 = 0;
+  blt->bltdmod = bltmod;
+  blt->bltafwm = bltafwm;
+  blt->bltalwm = bltalwm;
 }
 
 void BlitterSetAreaStart(short bplnum, u_short pattern) {
   void *bltpt = state->bitmap->planes[bplnum] + state->start;
   u_short bltsize = state->size;
+  volatile struct Custom *blt;
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
-  custom->bltcdat = pattern;
-  custom->bltbpt = bltpt;
-  custom->bltdpt = bltpt;
-  custom->bltsize = bltsize;
+  blt->bltcdat = pattern;
+  blt->bltbpt = bltpt;
+  blt->bltdpt = bltpt;
+  BlitterStart(blt, bltsize);
 }
@@ -5,7 +5,10 @@ void BlitterSetMaskArea(const BitmapT *dst, short dstbpl, u_short x, u_short y,
 {
   void *dstbpt = dst->planes[dstbpl];
   void *mskbpt = msk->planes[0];
+  u_short dststride = BitmapStride(dst);
+  u_short mskstride = BitmapStride(msk);
   u_short dstmod, mskmod, bltsize, bltshift;
+  volatile struct Custom *blt;
 
   if (area) {
     /* TODO: handle unaligned mx */
@@ -15,51 +18,51 @@ void BlitterSetMaskArea(const BitmapT *dst, short dstbpl, u_short x, u_short y,
     short mh = area->h;
     short bytesPerRow = ((mw + 15) & ~15) >> 3;
 
-    dstbpt += ((x >> 3) & ~1) + (short)y * (short)dst->bytesPerRow;
-    mskbpt += ((mx >> 3) & ~1) + (short)my * (short)msk->bytesPerRow;
-    dstmod = dst->bytesPerRow - bytesPerRow;
-    mskmod = msk->bytesPerRow - bytesPerRow;
+    dstbpt += ((x >> 3) & ~1) + (short)y * (short)dststride;
+    mskbpt += ((mx >> 3) & ~1) + (short)my * (short)mskstride;
+    dstmod = dststride - bytesPerRow;
+    mskmod = mskstride - bytesPerRow;
     bltsize = (mh << 6) | (bytesPerRow >> 1);
     bltshift = rorw(x & 15, 4);
   } else {
-    dstbpt += ((x >> 3) & ~1) + y * dst->bytesPerRow;
-    dstmod = dst->bytesPerRow - msk->bytesPerRow;
-    mskmod = dstmod;
+    dstbpt += ((x >> 3) & ~1) + y * dststride;
+    dstmod = dststride - msk->bytesPerRow;
+    mskmod = mskstride - msk->bytesPerRow;
     bltsize = (msk->height << 6) | (msk->bytesPerRow >> 1);
     bltshift = rorw(x & 15, 4);
   }
 
-  WaitBlitter();
+  blt = BlitterBegin();
 
   if (bltshift) {
     bltsize += 1; dstmod -= 2; mskmod -= 2;
 
-    custom->bltbmod = mskmod;
-    custom->bltcon0 = (SRCB|SRCC|DEST) | (ABC|ABNC|ANBC|NANBC) | bltshift;
-    custom->bltcon1 = bltshift;
-    custom->bltalwm = 0;
+    blt->bltbmod = mskmod;
+    blt->bltcon0 = (SRCB|SRCC|DEST) | (ABC|ABNC|ANBC|NANBC) | bltshift;
+    blt->bltcon1 = bltshift;
+    blt->bltalwm = 0;
 
-    custom->bltadat = pattern;
-    custom->bltbpt = mskbpt;
-    custom->bltcpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
-    custom->bltafwm = -1;
-    custom->bltsize = bltsize;
+    blt->bltadat = pattern;
+    blt->bltbpt = mskbpt;
+    blt->bltcpt = dstbpt;
+    blt->bltdpt = dstbpt;
+    blt->bltcmod = dstmod;
+    blt->bltdmod = dstmod;
+    blt->bltafwm = -1;
+    BlitterStart(blt, bltsize);
   } else {
-    custom->bltbmod = 0;
-    custom->bltcon0 = (SRCB|SRCC|DEST) | (ABC|ABNC|ANBC|NANBC);
-    custom->bltcon1 = 0;
-    custom->bltalwm = -1;
+    blt->bltbmod = mskmod;
+    blt->bltcon0 = (SRCB|SRCC|DEST) | (ABC|ABNC|ANBC|NANBC);
+    blt->bltcon1 = 0;
+    blt->bltalwm = -1;
 
-    custom->bltadat = pattern;
-    custom->bltbpt = mskbpt;
-    custom->bltcpt = dstbpt;
-    custom->bltdpt = dstbpt;
-    custom->bltcmod = dstmod;
-    custom->bltdmod = dstmod;
-    custom->bltafwm = -1;
-    custom->bltsize = bltsize;
+    blt->bltadat = pattern;
+    blt->bltbpt = mskbpt;
+    blt->bltcpt = dstbpt;
+    blt->bltdpt = dstbpt;
+    blt->bltcmod = dstmod;
+    blt->bltdmod = dstmod;
+    blt->bltafwm = -1;
+    BlitterStart(blt, bltsize);
   }
 }
@@ -0,0 +1,215 @@
+#include <blitter.h>
+#include <c2p.h>
+#include <debug.h>
+
+/* Blitter can't do more rows in one go. */
+#define MAXROWS 1024
+
+/* Each pass merges bits of two words selected by a mask into one word:
+ * - ascending:  (a & mask) | ((b >> shift) & ~mask)
+ * - descending: ((a << shift) & mask) | (b & ~mask) */
+#define MERGE ((SRCA | SRCB | DEST) | (ABC | ABNC | ANBC | NABNC))
+
+static void AddBlit(C2PT *c2p, bool reverse, short shift, u_short mask,
+                    void *apt, void *bpt, short abmod,
+                    void *dpt, short dmod, short width, short height)
+{
+  short abstep = (width << 1) + abmod;
+  short dstep = (width << 1) + dmod;
+
+  /* Tall blits are split into parts, each continuing where previous one
+   * ended, just as if it were the same blit. */
+  while (height > 0) {
+    short rows = min(height, MAXROWS);
+    int abdelta = rows * abstep;
+    int ddelta = rows * dstep;
+    BlitT *blit;
+
+    /* Number of blits grows with buffer size, as tall ones get split. */
+    if (c2p->count == C2P_MAXBLITS)
+      Panic("[C2P] Conversion needs more than %d blits!\n", C2P_MAXBLITS);
+
+    blit = &c2p->blit[c2p->count++];
+
+    blit->bltcon0 = MERGE | (reverse ? ASHIFT(shift) : 0);
+    blit->bltcon1 = reverse ? BLITREVERSE : BSHIFT(shift);
+    blit->bltafwm = -1;
+    blit->bltalwm = -1;
+    blit->bltamod = abmod;
+    blit->bltbmod = abmod;
+    blit->bltcmod = 0;
+    blit->bltdmod = dmod;
+    blit->bltadat = 0;
+    blit->bltbdat = 0;
+    blit->bltcdat = mask;
+    blit->bltapt = apt;
+    blit->bltbpt = bpt;
+    blit->bltcpt = NULL;
+    blit->bltdpt = dpt;
+    blit->bltsize = (rows << 6) | width;
+
+    if (reverse)
+      abdelta = -abdelta, ddelta = -ddelta;
+
+    apt += abdelta;
+    bpt += abdelta;
+    dpt += ddelta;
+    height -= rows;
+  }
+}
+
+/* Swaps bits between words `k` apart in groups of `2 * k` words. Results are
+ * stored at the same positions in `dst`.
+ * (see "Swap 8x4" or "Swap 4x2" in prototypes) */
+static void SwapStage(C2PT *c2p, void *src, void *dst, int size,
+                      short k, short shift, u_short mask)
+{
+  short bytes = k << 1;
+  short height = size / (bytes << 1);
+
+  AddBlit(c2p, false, shift, mask, src, src + bytes, bytes,
+          dst, bytes, k, height);
+  AddBlit(c2p, true, shift, mask, src + size - bytes - 2, src + size - 2,
+          bytes, dst + size - 2, bytes, k, height);
+}
+
+/* Merges words `a` and `b` of each group of four words into a bitplane. */
+static void PlaneBlit(C2PT *c2p, bool reverse, void *src, int size,
+                      short a, short b, short shift, u_short mask,
+                      void *plane)
+{
+  short height = size >> 3;
+
+  if (reverse)
+    AddBlit(c2p, true, shift, mask, src + size - 8 + (a << 1),
+            src + size - 8 + (b << 1), 6, plane + (size >> 2) - 2, 0,
+            1, height);
+  else
+    AddBlit(c2p, false, shift, mask, src + (a << 1), src + (b << 1), 6,
+            plane, 0, 1, height);
+}
+
+/* Blit of contiguous words is as wide as needed to fit in one go. */
+static void LinearBlit(C2PT *c2p, bool reverse, void *src, void *dst,
+                       int size, short shift, u_short mask)
+{
+  int words = size >> 1;
+  short width = 1;
+
+  while (width < 32 && (words % (width << 1)) == 0 && words / width > MAXROWS)
+    width <<= 1;
+
+  if (reverse)
+    AddBlit(c2p, true, shift, mask, src + size - 2, src + size - 2, 0,
+            dst + size - 2, 0, width, words / width);
+  else
+    AddBlit(c2p, false, shift, mask, src, src, 0, dst, 0, width,
+            words / width);
+}
+
+void C2PSetup(C2PT *c2p, u_short format, short width, short height,
+              void *chunky, void *scratch, void *planes[4])
+{
+  int size = (width * height) >> 1;
+  short i;
+
+  c2p->count = 0;
+
+  for (i = 0; i < 4; i++)
+    c2p->planes[i] = planes[i];
+
+  if (format == C2P_1X1_4BPL) {
+    SwapStage(c2p, chunky, scratch, size, 2, 8, 0xFF00);
+    SwapStage(c2p, scratch, chunky, size, 1, 4, 0xF0F0);
+    SwapStage(c2p, chunky, scratch, size, 2, 2, 0xCCCC);
+    PlaneBlit(c2p, false, scratch, size, 0, 1, 1, 0xAAAA, planes[3]);
+    PlaneBlit(c2p, true, scratch, size, 0, 1, 1, 0xAAAA, planes[2]);
+    PlaneBlit(c2p, false, scratch, size, 2, 3, 1, 0xAAAA, planes[1]);
+    PlaneBlit(c2p, true, scratch, size, 2, 3, 1, 0xAAAA, planes[0]);
+  } else if (format == C2P_1X1_4BPL_SCRAMBLED) {
+    SwapStage(c2p, chunky, scratch, size, 2, 8, 0xFF00);
+    SwapStage(c2p, scratch, chunky, size, 1, 4, 0xF0F0);
+    PlaneBlit(c2p, false, chunky, size, 0, 2, 2, 0xCCCC, planes[3]);
+    PlaneBlit(c2p, false, chunky, size, 1, 3, 2, 0xCCCC, planes[2]);
+    PlaneBlit(c2p, true, chunky, size, 0, 2, 2, 0xCCCC, planes[1]);
+    PlaneBlit(c2p, true, chunky, size, 1, 3, 2, 0xCCCC, planes[0]);
+  } else if (format == C2P_2X1_4BPL_MANGLED) {
+    short half = size >> 1;
+
+    /* Swap 4x2: upper half of scratch gets high bits, lower - low bits. */
+    AddBlit(c2p, false, 4, 0xF0F0, chunky, chunky + 2, 2,
+            scratch + half, 0, 1, size >> 2);
+    AddBlit(c2p, true, 4, 0xF0F0, chunky + size - 4, chunky + size - 2, 2,
+            scratch + half - 2, 0, 1, size >> 2);
+
+    /* Expand 2x1: every bit is doubled. If bitplane pairs are laid out one
+     * after another, each pair is filled with single blit. */
+    if (planes[2] == planes[0] + half && planes[3] == planes[1] + half) {
+      LinearBlit(c2p, false, scratch, planes[1], size, 1, 0xAAAA);
+      LinearBlit(c2p, true, scratch, planes[0], size, 1, 0xAAAA);
+    } else {
+      LinearBlit(c2p, false, scratch, planes[1], half, 1, 0xAAAA);
+      LinearBlit(c2p, false, scratch + half, planes[3], half, 1, 0xAAAA);
+      LinearBlit(c2p, true, scratch, planes[0], half, 1, 0xAAAA);
+      LinearBlit(c2p, true, scratch + half, planes[2], half, 1, 0xAAAA);
+    }
+  } else if (format == C2P_1X1_HAM6_MANGLED) {
+    size <<= 2;
+    SwapStage(c2p, chunky, scratch, size, 2, 8, 0xFF00);
+    PlaneBlit(c2p, false, scratch, size, 0, 1, 4, 0xF0F0, planes[3]);
+    PlaneBlit(c2p, true, scratch, size, 0, 1, 4, 0xF0F0, planes[2]);
+    PlaneBlit(c2p, false, scratch, size, 2, 3, 4, 0xF0F0, planes[1]);
+    PlaneBlit(c2p, true, scratch, size, 2, 3, 4, 0xF0F0, planes[0]);
+  }
+
+  c2p->phase = c2p->count + 1;
+}
+
+static inline void StartBlit(volatile struct Custom *blt, const BlitT *blit) {
+  blt->bltcon0 = blit->bltcon0;
+  blt->bltcon1 = blit->bltcon1;
+  blt->bltafwm = blit->bltafwm;
+  blt->bltalwm = blit->bltalwm;
+  blt->bltamod = blit->bltamod;
+  blt->bltbmod = blit->bltbmod;
+  blt->bltdmod = blit->bltdmod;
+  blt->bltcdat = blit->bltcdat;
+  blt->bltapt = blit->bltapt;
+  blt->bltbpt = blit->bltbpt;
+  blt->bltdpt = blit->bltdpt;
+}
+
+void C2PRun(C2PT *c2p) {
+  const BlitT *blit = c2p->blit;
+  short n = c2p->count;
+
+  while (--n >= 0) {
+    volatile struct Custom *blt = BlitterBegin();
+    StartBlit(blt, blit);
+    BlitterStart(blt, blit->bltsize);
+    blit++;
+  }
+
+  BlitterSync();
+  c2p->phase = c2p->count + 1;
+}
+
+bool C2PStep(C2PT *c2p) {
+  short phase = c2p->phase;
+
+  if (phase > c2p->count)
+    return false;
+
+  c2p->phase++;
+
+  if (phase == c2p->count)
+    return true;
+
+  {
+    const BlitT *blit = &c2p->blit[phase];
+    StartBlit(custom, blit);
+    custom->bltsize = blit->bltsize;
+  }
+
+  return false;
+}
@@ -0,0 +1,85 @@
+#include <blitchain.h>
+
+/* Remembers which registers were loaded by the chain so far and with what
+ * values, so that redundant MOVE instructions can be skipped. */
+typedef struct {
+  BlitT regs;
+  u_short valid;
+} ShadowT;
+
+#define R_BLTCON1 __BIT(0)
+#define R_BLTAFWM __BIT(1)
+#define R_BLTALWM __BIT(2)
+#define R_BLTAMOD __BIT(3)
+#define R_BLTBMOD __BIT(4)
+#define R_BLTCMOD __BIT(5)
+#define R_BLTDMOD __BIT(6)
+#define R_BLTADAT __BIT(7)
+#define R_BLTBDAT __BIT(8)
+#define R_BLTCDAT __BIT(9)
+
+#define LOAD(reg, flag)                                                        \
+  if (!(shadow.valid & (flag)) || shadow.regs.reg != blit->reg) {              \
+    CopMove16(list, reg, blit->reg);                                           \
+    shadow.regs.reg = blit->reg;                                               \
+    shadow.valid |= (flag);                                                    \
+  }
+
+void CopBlitChain(CopListT *list, const BlitT *blits, short n,
+                  CopBlitT *ins)
+{
+  ShadowT shadow;
+
+  shadow.valid = 0;
+
+  while (--n >= 0) {
+    const BlitT *blit = blits++;
+    u_short con0 = blit->bltcon0;
+    bool line = blit->bltcon1 & LINEMODE;
+    CopBlitT curr;
+
+    /* Blitter busy flag gets raised a few cycles after bltsize is written.
+     * Give the blitter some time before checking if it's finished. */
+    CopNoOp(list);
+    CopWaitBlitter(list);
+
+    LOAD(bltcon1, R_BLTCON1);
+    LOAD(bltafwm, R_BLTAFWM);
+    LOAD(bltalwm, R_BLTALWM);
+
+    /* Modulos matter only for channels with DMA enabled, or in line mode. */
+    if (line || (con0 & SRCA))
+      LOAD(bltamod, R_BLTAMOD);
+    if (line || (con0 & SRCB))
+      LOAD(bltbmod, R_BLTBMOD);
+    if (line || (con0 & SRCC))
+      LOAD(bltcmod, R_BLTCMOD);
+    if (line || (con0 & DEST))
+      LOAD(bltdmod, R_BLTDMOD);
+
+    /* Data registers of enabled channels get overwritten by DMA. */
+    if (line || !(con0 & SRCA))
+      LOAD(bltadat, R_BLTADAT);
+    if (line || !(con0 & SRCB))
+      LOAD(bltbdat, R_BLTBDAT);
+    if (line || !(con0 & SRCC))
+      LOAD(bltcdat, R_BLTCDAT);
+
+    if (con0 & SRCA)
+      shadow.valid &= ~R_BLTADAT;
+    if (con0 & SRCB)
+      shadow.valid &= ~R_BLTBDAT;
+    if (con0 & SRCC)
+      shadow.valid &= ~R_BLTCDAT;
+
+    curr.bltcon0 = CopMove16(list, bltcon0, con0);
+    curr.bltapt = (con0 & SRCA) ? CopMove32(list, bltapt, blit->bltapt) : NULL;
+    curr.bltbpt = (con0 & SRCB) ? CopMove32(list, bltbpt, blit->bltbpt) : NULL;
+    curr.bltcpt = (con0 & SRCC) ? CopMove32(list, bltcpt, blit->bltcpt) : NULL;
+    curr.bltdpt = (con0 & DEST) ? CopMove32(list, bltdpt, blit->bltdpt) : NULL;
+    curr.bltsize = CopMove16(list, bltsize, blit->bltsize);
+
+    if (ins)
+      *ins++ = curr;
+  }
+}
@@ -0,0 +1,176 @@
+#include <blitter.h>
+#include <coppatch.h>
+#include <system/memory.h>
+
+#define MAXROWS 1024
+
+/* Only slot values are read by the blitter, so the rest of arrays are
+ * allocated in one block that follows the structure. */
+CopPatchT *NewCopPatch(short count) {
+  int size = sizeof(CopPatchT) +
+    count * (2 * sizeof(CopInsT *) + 2 * sizeof(short)) + ((count + 1) & ~1);
+  CopPatchT *patch = MemAlloc(size, MEMF_PUBLIC|MEMF_CLEAR);
+  void *data = patch + 1;
+
+  patch->count = count;
+  patch->value = MemAlloc(count * sizeof(u_short), MEMF_CHIP|MEMF_CLEAR);
+  patch->slot[0] = data; data += count * sizeof(CopInsT *);
+  patch->slot[1] = data; data += count * sizeof(CopInsT *);
+  patch->queue[0] = data; data += count * sizeof(short);
+  patch->queue[1] = data; data += count * sizeof(short);
+  patch->flags = data;
+  return patch;
+}
+
+void DeleteCopPatch(CopPatchT *patch) {
+  MemFree(patch->value);
+  MemFree(patch);
+}
+
+CopInsT *CopPatchSlot(CopPatchT *patch, short n, short i, CopInsT *ins) {
+  CopInsT **slot = patch->slot[n];
+
+  slot[i] = ins;
+  patch->value[i] = ins->move.data;
+
+  if (i > 0 && slot[i - 1] + 1 == ins)
+    patch->flags[i] |= COPPATCH_NEXT << n;
+  else
+    patch->flags[i] &= ~(COPPATCH_NEXT << n);
+
+  return ins;
+}
+
+void _CopPatchQueue(CopPatchT *patch, short i) {
+  u_char *flags = &patch->flags[i];
+  short n;
+
+  for (n = 0; n < 2; n++) {
+    if (!(*flags & (COPPATCH_QUEUED << n))) {
+      *flags |= COPPATCH_QUEUED << n;
+      patch->queue[n][patch->queued[n]++] = i;
+    }
+  }
+}
+
+static void AddRange(CopPatchT *patch, short n, short first, short last) {
+  CopPatchRangeT *range = patch->range[n];
+  short count = patch->ranges[n];
+  short i;
+
+  /* Overlapping or adjacent ranges are merged. */
+  for (i = 0; i < count; i++, range++) {
+    if (first <= range->last + 1 && last >= range->first - 1) {
+      range->first = min(range->first, first);
+      range->last = max(range->last, last);
+      return;
+    }
+  }
+
+  /* List is full - extend the last range to cover the new one. */
+  if (count == COPPATCH_RANGES) {
+    range = &patch->range[n][count - 1];
+    range->first = min(range->first, first);
+    range->last = max(range->last, last);
+    return;
+  }
+
+  range->first = first;
+  range->last = last;
+  patch->ranges[n]++;
+}
+
+/* Copies `n` words from `src` to words `step` bytes apart at `dst`. */
+static void BlitWords(const u_short *src, void *dst, short step, short n) {
+  while (n > 0) {
+    short rows = min(n, MAXROWS);
+    volatile struct Custom *blt = BlitterBegin();
+
+    blt->bltcon0 = (SRCA | DEST) | A_TO_D;
+    blt->bltcon1 = 0;
+    blt->bltafwm = -1;
+    blt->bltalwm = -1;
+    blt->bltamod = 0;
+    blt->bltdmod = step - sizeof(u_short);
+    blt->bltapt = (void *)src;
+    blt->bltdpt = dst;
+    BlitterStart(blt, (rows << 6) | 1);
+
+    src += rows;
+    dst += rows * step;
+    n -= rows;
+  }
+}
+
+void CopPatchCopy(CopPatchT *patch, short i, const u_short *data, short n) {
+  if (n <= 0)
+    return;
+
+  BlitWords(data, &patch->value[i], sizeof(u_short), n);
+  AddRange(patch, 0, i, i + n - 1);
+  AddRange(patch, 1, i, i + n - 1);
+}
+
+void CopPatchFlush(CopPatchT *patch, short n) {
+  CopInsT **slot = patch->slot[n];
+  u_short *value = patch->value;
+  u_char *flags = patch->flags;
+  u_char next = COPPATCH_NEXT << n;
+  bool blit = patch->ranges[n] > 0;
+
+  /* Slot values may be still being copied by CopPatchCopy. */
+  if (blit)
+    BlitterSync();
+
+  /* Split ranges into runs of consecutive MOVEs. Long runs go to the blitter,
+   * which works while the CPU writes the rest. */
+  {
+    CopPatchRangeT *range = patch->range[n];
+    short count = patch->ranges[n];
+
+    while (--count >= 0) {
+      short i = range->first;
+      short last = range->last;
+
+      for (; i <= last; i++) {
+        short j = i;
+
+        while (j < last && (flags[j + 1] & next))
+          j++;
+
+        if (j - i + 1 >= COPPATCH_BLITMIN) {
+          /* Data words of consecutive MOVEs are 4 bytes apart. */
+          BlitWords(&value[i], &slot[i]->move.data, sizeof(CopInsT),
+                    j - i + 1);
+        } else {
+          short k;
+          for (k = i; k <= j; k++)
+            CopInsSet16(slot[k], value[k]);
+        }
+
+        i = j;
+      }
+
+      range++;
+    }
+
+    patch->ranges[n] = 0;
+  }
+
+  {
+    short *queue = patch->queue[n];
+    short count = patch->queued[n];
+    u_char queued = COPPATCH_QUEUED << n;
+
+    while (--count >= 0) {
+      short i = *queue++;
+      CopInsSet16(slot[i], value[i]);
+      flags[i] &= ~queued;
+    }
+
+    patch->queued[n] = 0;
+  }
+
+  if (blit)
+    BlitterSync();
+}
@@ -0,0 +1,137 @@
+#include <blitter.h>
+#include <dirtyrects.h>
+#include <limits.h>
+
+void DirtyRectsInit(DirtyRectsT *dirty, short buffers,
+                    const BitmapT *background)
+{
+  short i;
+
+  dirty->background = background;
+  dirty->buffers = buffers;
+  dirty->active = 0;
+
+  for (i = 0; i < DIRTY_BUFFERS; i++)
+    dirty->list[i].count = 0;
+}
+
+/* Number of words blitted for an area, including blit setup overhead. */
+static inline int Cost(const Area2D *a) {
+  return (a->w >> 4) * a->h + DIRTY_OVERHEAD;
+}
+
+static inline void Union(Area2D *u, const Area2D *a, const Area2D *b) {
+  short x1 = min(a->x, b->x);
+  short y1 = min(a->y, b->y);
+  short x2 = max(a->x + a->w, b->x + b->w);
+  short y2 = max(a->y + a->h, b->y + b->h);
+
+  u->x = x1;
+  u->y = y1;
+  u->w = x2 - x1;
+  u->h = y2 - y1;
+}
+
+void DirtyRectsAdd(DirtyRectsT *dirty, const Area2D *area) {
+  DirtyListT *list = &dirty->list[dirty->active];
+  Area2D new;
+  short i;
+
+  if (area->w <= 0 || area->h <= 0)
+    return;
+
+  new.x = area->x & ~15;
+  new.y = area->y;
+  new.w = ((area->x + area->w + 15) & ~15) - new.x;
+  new.h = area->h;
+
+  /* Merge with each rectangle, if that doesn't make restoring more expensive.
+   * Resulting bounding box may now be mergeable with rectangles that were
+   * already checked, so start over. */
+  for (i = 0; i < list->count; i++) {
+    Area2D *curr = &list->area[i];
+    Area2D u;
+
+    Union(&u, curr, &new);
+
+    if (Cost(&u) <= Cost(curr) + Cost(&new)) {
+      new = u;
+      *curr = list->area[--list->count];
+      i = -1;
+    }
+  }
+
+  /* List is full - merge with the rectangle that grows the least. */
+  if (list->count == DIRTY_MAX) {
+    int best = INT_MAX;
+    short j = 0;
+
+    for (i = 0; i < list->count; i++) {
+      Area2D u;
+      int growth;
+
+      Union(&u, &list->area[i], &new);
+      growth = Cost(&u) - Cost(&list->area[i]);
+      if (growth < best) {
+        best = growth;
+        j = i;
+      }
+    }
+
+    Union(&list->area[j], &list->area[j], &new);
+    return;
+  }
+
+  list->area[list->count++] = new;
+}
+
+static void RestoreArea(const BitmapT *dst, const BitmapT *bg,
+                        const Area2D *area)
+{
+  short i = 0;
+
+  if (bg) {
+    short n = min(dst->depth, bg->depth);
+
+    if (BitmapFlattenable(dst, bg)) {
+      BitmapCopyArea(dst, area->x, area->y, bg, area);
+      return;
+    }
+
+    BlitterCopyAreaSetup(dst, area->x, area->y, bg, area);
+    for (; i < n; i++)
+      BlitterCopyAreaStart(i, i);
+
+    if (i == dst->depth)
+      return;
+  } else if (dst->flags & BM_INTERLEAVED) {
+    BitmapClearArea(dst, area);
+    return;
+  }
+
+  /* Bitplanes missing in background (if any) are cleared. */
+  BlitterSetAreaSetup(dst, area);
+  for (; i < dst->depth; i++)
+    BlitterSetAreaStart(i, 0);
+}
+
+void DirtyRectsRestore(DirtyRectsT *dirty, const BitmapT *dst) {
+  DirtyListT *list = &dirty->list[dirty->active];
+  Area2D *area = list->area;
+  short n = list->count;
+
+  while (--n >= 0) {
+    Area2D a = *area++;
+
+    /* Clip to destination bitmap. */
+    if (a.x < 0) { a.w += a.x; a.x = 0; }
+    if (a.y < 0) { a.h += a.y; a.y = 0; }
+    if (a.x + a.w > dst->width) { a.w = dst->width - a.x; }
+    if (a.y + a.h > dst->height) { a.h = dst->height - a.y; }
+
+    if (a.w > 0 && a.h > 0)
+      RestoreArea(dst, dirty->background, &a);
+  }
+
+  list->count = 0;
+}
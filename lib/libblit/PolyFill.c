@@ -0,0 +1,151 @@
+#include <blitter.h>
+#include <polyfill.h>
+
+void PolyFillInit(PolyFillT *fill, const BitmapT *target,
+                  const BitmapT *scratch)
+{
+  fill->target = target;
+  fill->scratch = scratch;
+  fill->color = 0;
+  fill->count = 0;
+  fill->edges = 0;
+}
+
+/* Fill area of a box is extended to word boundaries. */
+static inline void BoxArea(Area2D *area, const Box2D *box) {
+  area->x = box->minX & ~15;
+  area->y = box->minY;
+  area->w = ((box->maxX + 16) & ~15) - area->x;
+  area->h = box->maxY - box->minY + 1;
+}
+
+/* Number of words blitted for a box, including blit setup overhead. */
+static inline int Cost(const Box2D *box) {
+  Area2D area;
+  BoxArea(&area, box);
+  return (area.w >> 4) * area.h + POLYFILL_OVERHEAD;
+}
+
+static inline void Union(Box2D *u, const Box2D *a, const Box2D *b) {
+  u->minX = min(a->minX, b->minX);
+  u->minY = min(a->minY, b->minY);
+  u->maxX = max(a->maxX, b->maxX);
+  u->maxY = max(a->maxY, b->maxY);
+}
+
+static inline bool Overlap(const Box2D *a, const Box2D *b) {
+  return a->minX <= b->maxX && b->minX <= a->maxX &&
+         a->minY <= b->maxY && b->minY <= a->maxY;
+}
+
+/* Filling relies on every row of a polygon having even number of dots, which
+ * means that fill-friendly one-dot mode must be used, and the edges must be
+ * eor'ed, so that dots of two edges meeting at a bottom vertex cancel out. */
+static void DrawEdges(PolyFillT *fill) {
+  if (fill->edges == 0)
+    return;
+
+  BlitterLineSetup(fill->scratch, 0, LINE_EOR|LINE_ONEDOT);
+  BlitterLines(fill->edge, fill->edges);
+  fill->edges = 0;
+}
+
+/* Does the polygon need to go into a new batch? */
+static bool MustFlush(PolyFillT *fill, const Box2D *box, u_short color) {
+  Box2D u;
+  short i;
+
+  if (fill->count == 0)
+    return false;
+
+  if (fill->count == POLYFILL_BATCH || fill->color != color)
+    return true;
+
+  /* Edges of overlapping polygons would break filling of one another. */
+  for (i = 0; i < fill->count; i++)
+    if (Overlap(&fill->box[i], box))
+      return true;
+
+  Union(&u, &fill->bound, box);
+  return Cost(&u) > Cost(&fill->bound) + Cost(box);
+}
+
+void PolyFillAdd(PolyFillT *fill, const Point2D *points, short n,
+                 u_short color)
+{
+  const Point2D *prev = &points[n - 1];
+  const Point2D *curr = points;
+  Box2D box;
+  short i;
+
+  box.minX = box.maxX = prev->x;
+  box.minY = box.maxY = prev->y;
+
+  for (i = 0; i < n; i++, curr++) {
+    if (curr->x < box.minX)
+      box.minX = curr->x;
+    else if (curr->x > box.maxX)
+      box.maxX = curr->x;
+    if (curr->y < box.minY)
+      box.minY = curr->y;
+    else if (curr->y > box.maxY)
+      box.maxY = curr->y;
+  }
+
+  /* One-dot mode leaves flat polygons empty. */
+  if (box.minY == box.maxY)
+    return;
+
+  if (MustFlush(fill, &box, color))
+    PolyFillFlush(fill);
+
+  if (fill->count == 0) {
+    fill->color = color;
+    fill->bound = box;
+  } else {
+    Union(&fill->bound, &fill->bound, &box);
+  }
+
+  fill->box[fill->count++] = box;
+
+  /* Horizontal edges do not contribute any dots, so skip them. */
+  for (i = 0, curr = points; i < n; i++, prev = curr++) {
+    Line2D *edge;
+
+    if (prev->y == curr->y)
+      continue;
+
+    if (fill->edges == POLYFILL_EDGES)
+      DrawEdges(fill);
+
+    edge = &fill->edge[fill->edges++];
+    edge->x1 = prev->x;
+    edge->y1 = prev->y;
+    edge->x2 = curr->x;
+    edge->y2 = curr->y;
+  }
+}
+
+void PolyFillFlush(PolyFillT *fill) {
+  const BitmapT *target = fill->target;
+  const BitmapT *scratch = fill->scratch;
+  Area2D area;
+  short i;
+
+  if (fill->count == 0)
+    return;
+
+  DrawEdges(fill);
+
+  BoxArea(&area, &fill->bound);
+  BlitterFillArea(scratch, 0, &area);
+
+  for (i = 0; i < target->depth; i++) {
+    u_short pattern = (fill->color & (1 << i)) ? -1 : 0;
+    BlitterSetMaskArea(target, i, area.x, area.y, scratch, &area, pattern);
+  }
+
+  BlitterSetArea(scratch, 0, &area, 0);
+
+  fill->count = 0;
+}
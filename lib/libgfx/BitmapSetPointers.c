@@ -5,9 +5,14 @@ void BitmapSetPointers(BitmapT *bitmap, void *planes) {
     (bitmap->flags & BM_INTERLEAVED) ? bitmap->bytesPerRow : bitmap->bplSize;
   short depth = bitmap->depth;
   void **planePtr = bitmap->planes;
+  void *end = planes + bitmap->bplSize * depth;
 
   do {
     *planePtr++ = planes;
     planes += modulo;
   } while (depth--);
+
+  /* Extra pointer must refer to scratchpad area that follows bitmap data. */
+  if (bitmap->flags & BM_INTERLEAVED)
+    bitmap->planes[bitmap->depth] = end;
 }
@@ -33,21 +33,31 @@ static void DrawFrame(BitmapT *bitmap, Area2D *area, GuiFrameT frame) {
 
   if (frame) {
     /* WC_FRAME_IN = 0b10 */
+    Line2D border[4] = {
+      { x1, y1, x2, y1 },
+      { x1, y2, x2, y2 },
+      { x1, y1 + 1, x1, y2 - 1 },
+      { x2, y1 + 1, x2, y2 - 1 }
+    };
+
     BlitterLineSetup(bitmap, 1, LINE_OR|LINE_SOLID);
-    BlitterLine(x1, y1, x2, y1);
-    BlitterLine(x1, y2, x2, y2);
-    BlitterLine(x1, y1 + 1, x1, y2 - 1);
-    BlitterLine(x2, y1 + 1, x2, y2 - 1);
+    BlitterLines(border, 4);
 
     /* WC_FRAME_OUT = 0b11 */
     BlitterLineSetup(bitmap, 0, LINE_EOR|LINE_SOLID);
 
     if (frame == FRAME_IN) {
-      BlitterLine(x2, y1 + 1, x2, y2);
-      BlitterLine(x1 + 1, y2, x2 - 1, y2);
+      Line2D shade[2] = {
+        { x2, y1 + 1, x2, y2 },
+        { x1 + 1, y2, x2 - 1, y2 }
+      };
+      BlitterLines(shade, 2);
     } else if (frame == FRAME_OUT) {
-      BlitterLine(x1, y1, x2, y1);
-      BlitterLine(x1, y1 + 1, x1, y2);
+      Line2D shade[2] = {
+        { x1, y1, x2, y1 },
+        { x1, y1 + 1, x1, y2 }
+      };
+      BlitterLines(shade, 2);
     }
   }
 }
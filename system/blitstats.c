@@ -0,0 +1,138 @@
+#include <debug.h>
+#include <blitter.h>
+#include <common.h>
+#include <strings.h>
+#include <system/blitstats.h>
+#include <system/interrupt.h>
+#include <system/task.h>
+
+#define LINE_CLOCKS 227                   /* color clocks per raster line */
+#define FRAME_CLOCKS (313 * LINE_CLOCKS)  /* color clocks per PAL frame */
+
+typedef struct BlitCounters {
+  u_int wait;  /* color clocks CPU spent in WaitBlitter */
+  u_int idle;  /* color clocks blitter was idle while CPU waited for VBlank */
+  u_int blits; /* number of blits finished */
+} BlitCountersT;
+
+static bool Enabled;
+static BlitCountersT Frame, Total, Max;
+static u_short Frames;
+static int WaitStart = -1; /* beam position when TaskWaitVBlank was called */
+static int LastBlitDone;   /* beam position when last blit finished */
+
+/* Blitter interrupt handler that was installed before counters were started,
+ * e.g. by effect's Init. It's called after each finished blit is counted. */
+static IntVecEntryT Chained;
+static bool WasEnabled;
+
+/* Beam position in color clocks since the start of a frame. */
+static inline int BeamPos(void) {
+  u_int vpos = custom->vposr_;
+  return ((vpos >> 8) & 0x1ff) * LINE_CLOCKS + (vpos & 0xff);
+}
+
+static inline int Elapsed(int start, int end) {
+  int d = end - start;
+  return d < 0 ? d + FRAME_CLOCKS : d;
+}
+
+void _WaitBlitterStats(void) {
+  if (BlitterBusy()) {
+    int start = BeamPos();
+    _WaitBlitter(custom);
+    Frame.wait += Elapsed(start, BeamPos());
+  }
+}
+
+/* Pending interrupt flag has already been cleared by EnterIntr. */
+static void BlitterDone(void) {
+  LastBlitDone = BeamPos();
+  Frame.blits++;
+  Chained.code(Chained.data);
+}
+
+/* Called with interrupts disabled just before the task goes to sleep. */
+void BlitStatsWaitVBlank(void) {
+  if (Enabled)
+    WaitStart = BeamPos();
+}
+
+static void BlitStatsVBlank(void) {
+  if (WaitStart >= 0) {
+    int now = BeamPos();
+    int start = WaitStart;
+
+    if (BlitterBusy())
+      start = now;
+    else if (Elapsed(start, LastBlitDone) < Elapsed(start, now))
+      start = LastBlitDone;
+
+    Frame.idle += Elapsed(start, now);
+    WaitStart = -1;
+  }
+
+  Total.wait += Frame.wait;
+  Total.idle += Frame.idle;
+  Total.blits += Frame.blits;
+  Max.wait = max(Max.wait, Frame.wait);
+  Max.idle = max(Max.idle, Frame.idle);
+  Max.blits = max(Max.blits, Frame.blits);
+  Frames++;
+
+  Frame.wait = 0;
+  Frame.idle = 0;
+  Frame.blits = 0;
+}
+
+INTSERVER(BlitStatsServer, 0, (IntFuncT)BlitStatsVBlank, NULL);
+
+void BlitStatsStart(void) {
+  bzero(&Frame, sizeof(BlitCountersT));
+  bzero(&Total, sizeof(BlitCountersT));
+  bzero(&Max, sizeof(BlitCountersT));
+  Frames = 0;
+  WaitStart = -1;
+  Enabled = true;
+
+  /* Interrupt may already be in use (C2PStep, blitter queue), so keep its
+   * handler running and don't drop pending request. */
+  IntrDisable();
+  Chained = IntVec[INTB_BLIT];
+  WasEnabled = custom->intenar & INTF_BLIT;
+  SetIntVector(INTB_BLIT, (IntHandlerT)BlitterDone, NULL);
+  if (!WasEnabled)
+    ClearIRQ(INTF_BLIT);
+  EnableINT(INTF_BLIT);
+  IntrEnable();
+  AddIntServer(INTB_VERTB, BlitStatsServer);
+}
+
+void BlitStatsStop(void) {
+  if (!Enabled)
+    return;
+
+  Enabled = false;
+
+  /* Put back previous handler, unless the effect has installed its own since
+   * counters were started. */
+  IntrDisable();
+  if (IntVec[INTB_BLIT].code == (IntHandlerT)BlitterDone) {
+    if (!WasEnabled)
+      DisableINT(INTF_BLIT);
+    SetIntVector(INTB_BLIT, Chained.code, Chained.data);
+  }
+  IntrEnable();
+  RemIntServer(INTB_VERTB, BlitStatsServer);
+
+  if (Frames == 0)
+    return;
+
+  Log("[BlitStats] %d frames, per frame average (max):\n", Frames);
+  Log("[BlitStats] blits: %d (%d)\n",
+      (int)(Total.blits / Frames), (int)Max.blits);
+  Log("[BlitStats] CPU waiting for blitter: %d (%d) lines\n",
+      (int)(Total.wait / Frames / LINE_CLOCKS), (int)(Max.wait / LINE_CLOCKS));
+  Log("[BlitStats] blitter idle during VBlank wait: %d (%d) lines\n",
+      (int)(Total.idle / Frames / LINE_CLOCKS), (int)(Max.idle / LINE_CLOCKS));
+}
@@ -0,0 +1,29 @@
+#include <debug.h>
+#include <system/cache.h>
+#include <system/file.h>
+#include <system/ramdisk.h>
+
+bool CacheLoad(const char *name asm("a0"), void *buf asm("a1"),
+               u_int size asm("d0")) {
+  FileT *f;
+  bool hit = false;
+
+  if ((f = RamOpen(name, 0))) {
+    if (FileSeek(f, 0, SEEK_END) == (int)size) {
+      FileSeek(f, 0, SEEK_SET);
+      hit = (FileRead(f, buf, size) == (int)size);
+    }
+    FileClose(f);
+  }
+
+  Log("[Cache] %s '%s'.\n", hit ? "Hit" : "Miss", name);
+  return hit;
+}
+
+void CacheStore(const char *name asm("a0"), const void *buf asm("a1"),
+                u_int size asm("d0")) {
+  FileT *f = RamOpen(name, RAM_CREATE|RAM_TRUNC);
+  FileWrite(f, buf, size);
+  FileClose(f);
+  Log("[Cache] Stored '%s' (%d bytes).\n", name, size);
+}
@@ -1,11 +1,140 @@
 #include "debug.h"
 
-#ifndef UAE
+#if defined(LOGBIN) || !defined(UAE)
 #include <stdarg.h>
 #include <stdio.h>
+#include <system/cia.h>
 
 extern void DPutChar(void *ptr, char data);
+#endif
+
+#ifdef LOGBIN
+#include <system/amigahunk.h>
+#include <system/cpu.h>
+#include <system/exception.h>
+#ifdef UAE
+#include <uae.h>
+#endif
+
+/*
+ * Each record starts with a header longword: number of arguments in the top
+ * byte and address of format string in lower 24 bits, followed by arguments.
+ * Record with NULL format string is a control record, first argument of which
+ * describes its kind.
+ */
+#define LOG_SEGMENTS 0 /* runtime addresses of executable segments */
+#define LOG_DROPPED 1  /* number of records lost due to buffer overflow */
+#define LOG_HUNKS 2    /* name and runtime addresses of loaded executable */
+
+#define LOGBUF_SIZE 2048 /* in longwords, must be power of two */
+#define LOGBUF_MASK (LOGBUF_SIZE - 1)
+
+static u_int LogBuf[LOGBUF_SIZE];
+static volatile u_short LogHead, LogTail;
+static u_short LogDropped;
+static bool LogSynced;
+
+#define LogPush(head, data)                                                    \
+  { LogBuf[head] = (data); head = (head + 1) & LOGBUF_MASK; }
+
+void _LogBin(short nargs, const char *format, ...) {
+  u_short ipl = SetIPL(IPL_MAX);
+  u_short head = LogHead;
+
+  if (((LogTail - head - 1) & LOGBUF_MASK) > (u_short)nargs) {
+    va_list args;
+
+    LogPush(head, ((u_int)nargs << 24) | ((u_int)format & 0xffffff));
+
+    va_start(args, format);
+    while (--nargs >= 0)
+      LogPush(head, va_arg(args, u_int));
+    va_end(args);
+
+    LogHead = head;
+  } else {
+    LogDropped++;
+  }
+
+  (void)SetIPL(ipl);
+}
+
+static void LogPutLong(u_int data) {
+#ifdef UAE
+  UaeLog("@%08x\n", data);
+#else
+  DPutChar((void *)ciab, data >> 24);
+  DPutChar((void *)ciab, data >> 16);
+  DPutChar((void *)ciab, data >> 8);
+  DPutChar((void *)ciab, data);
+#endif
+}
+
+/* Tell the host where the executable was loaded, so it can find format
+ * strings. Hunk list pointer is stored by SetupExceptionVector. */
+static void LogSegments(void) {
+  HunkT *hunk;
+  short n = 1;
+
+  for (hunk = (HunkT *)ExcVec[1]; hunk; hunk = hunk->next)
+    n++;
+
+  LogPutLong((u_int)n << 24);
+  LogPutLong(LOG_SEGMENTS);
+  for (hunk = (HunkT *)ExcVec[1]; hunk; hunk = hunk->next)
+    LogPutLong((u_int)hunk->data);
+}
+
+/* Unlike segments of the kernel, the record is queued, so that the host learns
+ * about the executable before it decodes messages logged by it. */
+void LogHunks(const char *name, HunkT *hunks) {
+  u_short ipl = SetIPL(IPL_MAX);
+  u_short head = LogHead;
+  short nargs = 2;
+  HunkT *hunk;
+
+  for (hunk = hunks; hunk; hunk = hunk->next)
+    nargs++;
 
+  if (((LogTail - head - 1) & LOGBUF_MASK) > (u_short)nargs) {
+    LogPush(head, (u_int)nargs << 24);
+    LogPush(head, LOG_HUNKS);
+    LogPush(head, (u_int)name);
+    for (hunk = hunks; hunk; hunk = hunk->next)
+      LogPush(head, (u_int)hunk->data);
+    LogHead = head;
+  } else {
+    LogDropped++;
+  }
+
+  (void)SetIPL(ipl);
+}
+
+void LogDrain(int nlongs asm("d0")) {
+  if (!LogSynced) {
+    LogSegments();
+    LogSynced = true;
+  }
+
+  if (LogDropped) {
+    u_short ipl = SetIPL(IPL_MAX);
+    u_short dropped = LogDropped;
+    LogDropped = 0;
+    (void)SetIPL(ipl);
+
+    LogPutLong(2 << 24);
+    LogPutLong(LOG_DROPPED);
+    LogPutLong(dropped);
+  }
+
+  /* Records are always complete in the buffer, so it's safe to send them
+   * a longword at a time. Producer never touches LogTail. */
+  while (LogTail != LogHead && nlongs--) {
+    LogPutLong(LogBuf[LogTail]);
+    LogTail = (LogTail + 1) & LOGBUF_MASK;
+  }
+}
+#elif !defined(UAE)
 void Log(const char *format, ...) {
   va_list args;
 
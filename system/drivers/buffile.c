@@ -0,0 +1,115 @@
+#include <debug.h>
+#include <common.h>
+#include <string.h>
+#include <system/buffile.h>
+#include <system/errno.h>
+#include <system/file.h>
+#include <system/memory.h>
+
+struct File {
+  FileOpsT *ops;
+  FileT *parent;
+  u_char *buf;
+  u_int size;   /* size of the buffer */
+  u_int pos;    /* position of next byte to be read from the buffer */
+  u_int len;    /* number of valid bytes in the buffer */
+};
+
+static int BufRead(FileT *f, void *buf, u_int nbyte);
+static int BufSeek(FileT *f, int offset, int whence);
+static void BufClose(FileT *f);
+
+static FileOpsT BufOps = {
+  .read = BufRead,
+  .write = NoWrite,
+  .seek = BufSeek,
+  .close = BufClose
+};
+
+FileT *BufOpen(FileT *parent, u_int bufsize) {
+  FileT *f = MemAlloc(sizeof(FileT) + bufsize, MEMF_PUBLIC);
+  f->ops = &BufOps;
+  f->parent = parent;
+  f->buf = (u_char *)(f + 1);
+  f->size = bufsize;
+  f->pos = 0;
+  f->len = 0;
+  return f;
+}
+
+static void BufClose(FileT *f) {
+  /* Give back the bytes that were read ahead but not consumed. */
+  if (f->pos < f->len)
+    (void)FileSeek(f->parent, f->pos - f->len, SEEK_CUR);
+  MemFree(f);
+}
+
+static int BufRead(FileT *f, void *buf, u_int nbyte) {
+  u_int left = nbyte;
+
+  Debug("$%p $%p %d+%d", f, buf, f->pos, nbyte);
+
+  while (left > 0) {
+    u_int avail = f->len - f->pos;
+
+    if (avail == 0) {
+      int res;
+
+      /* Large reads bypass the buffer and go straight to the parent. */
+      if (left >= f->size) {
+        if ((res = FileRead(f->parent, buf, left)) < 0)
+          return res;
+        left -= res;
+        break;
+      }
+
+      f->pos = 0;
+      f->len = 0;
+
+      if ((res = FileRead(f->parent, f->buf, f->size)) < 0)
+        return res;
+      if (res == 0)
+        break;
+
+      f->len = res;
+      avail = res;
+    }
+
+    avail = min(avail, left);
+
+    memcpy(buf, f->buf + f->pos, avail);
+
+    buf += avail;
+    left -= avail;
+    f->pos += avail;
+  }
+
+  return nbyte - left;
+}
+
+static int BufSeek(FileT *f, int offset, int whence) {
+  Debug("$%p %d %d", f, offset, whence);
+
+  if (whence == SEEK_CUR) {
+    int pos = f->pos + offset;
+
+    /* Do not bother parent if new position is still within the buffer. */
+    if (pos >= 0 && pos <= (int)f->len) {
+      int res;
+      f->pos = pos;
+      if ((res = FileSeek(f->parent, 0, SEEK_CUR)) < 0)
+        return res;
+      return res - (f->len - f->pos);
+    }
+
+    /* Parent cursor is ahead of logical position by unread bytes. */
+    offset -= f->len - f->pos;
+  } else if (whence != SEEK_SET && whence != SEEK_END) {
+    return EINVAL;
+  }
+
+  f->pos = 0;
+  f->len = 0;
+
+  return FileSeek(f->parent, offset, whence);
+}
@@ -77,6 +77,15 @@ CIATimerT *AcquireTimer(u_int num asm("d0")) {
 }
 
 void ReleaseTimer(CIATimerT *timer asm("a0")) {
+  CIAPtrT cia = timer->cia;
+
+  /* Timer may have been set up in continuous mode, so stop it. */
+  WriteICR(cia, timer->icr);
+  if (timer->icr == CIAICRF_TB)
+    cia->ciacrb &= ~CIACRF_START;
+  else
+    cia->ciacra &= ~CIACRF_START;
+
   MutexLock(&TimerMtx);
   {
     u_int irq = (timer->num & 2) ? INTB_EXTER : INTB_PORTS;
@@ -1,6 +1,7 @@
 #include <debug.h>
 #include <system/cpu.h>
 #include <system/event.h>
+#include <system/replay.h>
 #include <system/task.h>
 
 #define QUEUELEN 32
@@ -19,9 +20,17 @@ static void _PushEvent(EventT *event) {
 }
 
 void PushEventISR(EventT *event) {
+#ifdef REPLAY
+  /* Input devices are ignored, events come from replay data. */
+  (void)event;
+#else
   u_short ipl = SetIPL(SR_IM);
+#ifdef RECORD
+  RecordEvent(event);
+#endif
   _PushEvent(event);
   (void)SetIPL(ipl);
+#endif
 }
 
 void PushEvent(EventT *event asm("a0")) {
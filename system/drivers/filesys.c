@@ -6,17 +6,23 @@
 #include <system/file.h>
 #include <system/filesys.h>
 #include <system/floppy.h>
+#include <system/memfile.h>
 #include <system/memory.h>
+#include <system/mutex.h>
 
 #define IOF_EOF 0x0002
 #define IOF_ERR 0x8000
 
+/* File type flags (see tools/fsutil.py). */
+#define FE_EXEC 1    /* file is an executable */
+#define FE_PACKED 2  /* file is a raw DEFLATE stream preceded by its size */
+
 /* On disk directory entries are always aligned to 2-byte boundary. */
 typedef struct FileEntry {
   u_char   reclen;   /* total size of this record in bytes */
-  u_char   type;     /* type of file (1: executable, 0: regular) */
+  u_char   type;     /* type of file (FE_* flags) */
   u_short  start;    /* sector where the file begins (0..1759) */
-  u_int    size;     /* file size in bytes (up to 1MiB) */
+  u_int    size;     /* file size in bytes (up to 1MiB), after inflation */
   char     name[0];  /* name of the file (NUL terminated) */
 } FileEntryT;
 
@@ -25,6 +31,9 @@ static FileEntryT *NextFileEntry(FileEntryT *fe) {
 }
 
 static FileT *FileSysDev;
+/* Serializes seek & read on the device, since parts can be read in background
+ * task while main task accesses other files. */
+static MUTEX(FileSysMtx);
 /* Finished by NUL character (reclen = 0). */
 static FileEntryT *FileSysRootDir;
 
@@ -63,6 +72,27 @@ static FileEntryT *LookupFile(const char *path) {
   return NULL;
 }
 
+#define ONSTACK(x) (&(x)), sizeof((x))
+
+/* Packed file is inflated as a whole into memory, so reading it later on
+ * doesn't involve the device. */
+static FileT *OpenPacked(FileEntryT *entry) {
+  u_int length;
+  void *packed;
+  FileT *f;
+
+  MutexLock(&FileSysMtx);
+  (void)FileSeek(FileSysDev, (entry->start + 2) * SECTOR_SIZE, SEEK_SET);
+  (void)FileRead(FileSysDev, ONSTACK(length));
+  packed = MemAlloc(length, MEMF_PUBLIC);
+  (void)FileRead(FileSysDev, packed, length);
+  MutexUnlock(&FileSysMtx);
+
+  f = MemOpenInflate(packed, entry->size);
+  MemFree(packed);
+  return f;
+}
+
 FileT *OpenFile(const char *path asm("a0")) {
   FileEntryT *entry;
   FileT *f;
@@ -70,6 +100,9 @@ FileT *OpenFile(const char *path asm("a0")) {
   if (!(entry = LookupFile(path)))
     return NULL;
 
+  if (entry->type & FE_PACKED)
+    return OpenPacked(entry);
+
   f = MemAlloc(sizeof(FileT), MEMF_PUBLIC|MEMF_CLEAR);
   f->ops = &FsOps;
   f->start = (entry->start + 2) * SECTOR_SIZE;
@@ -97,9 +130,12 @@ static int FsRead(FileT *f, void *buf, u_int nbyte) {
 
   left = min(left, f->size - f->pos);
 
+  MutexLock(&FileSysMtx);
   (void)FileSeek(FileSysDev, f->pos + f->start, SEEK_SET);
+  res = FileRead(FileSysDev, buf, left);
+  MutexUnlock(&FileSysMtx);
 
-  if ((res = FileRead(FileSysDev, buf, left)) < 0)
+  if (res < 0)
     return res;
 
   f->pos += res;
@@ -137,8 +173,6 @@ static int FsSeek(FileT *f, int offset, int whence) {
   return EINVAL;
 }
 
-#define ONSTACK(x) (&(x)), sizeof((x))
-
 void InitFileSys(FileT *dev) {
   u_short rootDirLen;
 
@@ -161,7 +195,8 @@ void InitFileSys(FileT *dev) {
     FileEntryT *fe = FileSysRootDir;
     do {
       Log("[FileSys] Sector %d: %s file '%s' of %d bytes.\n",
-          fe->start, fe->type ? "executable" : "regular", fe->name, fe->size);
+          fe->start, (fe->type & FE_EXEC) ? "executable" : "regular",
+          fe->name, fe->size);
       fe = NextFileEntry(fe);
     } while (fe->reclen);
   }
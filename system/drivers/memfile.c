@@ -1,4 +1,5 @@
 #include <debug.h>
+#include <inflate.h>
 #include <string.h>
 #include <system/errno.h>
 #include <system/file.h>
@@ -10,6 +11,7 @@ struct File {
   const void *buf;
   u_int offset;
   int length;
+  bool owner; /* buffer is released on close */
 };
 
 static int MemRead(FileT *f, void *buf, u_int nbyte);
@@ -29,10 +31,27 @@ FileT *MemOpen(const void *buf, u_int length) {
   f->buf = buf;
   f->length = length;
   f->offset = 0;
+  f->owner = false;
+  return f;
+}
+
+FileT *MemOpenInflate(const void *packed, u_int length) {
+  void *buf = MemAlloc(length, MEMF_PUBLIC);
+  u_char *storage = MemAlloc(INFLATE_STORAGE, MEMF_PUBLIC);
+  FileT *f;
+
+  Log("[MemFile] Inflating %d bytes from $%p.\n", length, packed);
+  Inflate(packed, buf, storage + INFLATE_STORAGE);
+  MemFree(storage);
+
+  f = MemOpen(buf, length);
+  f->owner = true;
   return f;
 }
 
 static void MemClose(FileT *f) {
+  if (f->owner)
+    MemFree((void *)f->buf);
   MemFree(f);
 }
 
@@ -0,0 +1,182 @@
+#include <debug.h>
+#include <common.h>
+#include <string.h>
+#include <strings.h>
+#include <system/errno.h>
+#include <system/file.h>
+#include <system/memory.h>
+#include <system/mutex.h>
+#include <system/queue.h>
+#include <system/ramdisk.h>
+
+typedef struct RamEntry {
+  TAILQ_ENTRY(RamEntry) link;
+  void *data;
+  u_int size;     /* number of bytes in the file */
+  u_int capacity; /* size of data block */
+  u_int attr;     /* memory attributes of data block */
+  short refcnt;   /* number of open files */
+  bool unlinked;  /* deleted while still open */
+  char name[0];
+} RamEntryT;
+
+static TAILQ_HEAD(, RamEntry) RamDir = TAILQ_HEAD_INITIALIZER(RamDir);
+static MUTEX(RamMtx);
+
+struct File {
+  FileOpsT *ops;
+  RamEntryT *entry;
+  u_int pos;
+};
+
+static int RamRead(FileT *f, void *buf, u_int nbyte);
+static int RamWrite(FileT *f, const void *buf, u_int nbyte);
+static int RamSeek(FileT *f, int offset, int whence);
+static void RamClose(FileT *f);
+
+static FileOpsT RamOps = {
+  .read = RamRead,
+  .write = RamWrite,
+  .seek = RamSeek,
+  .close = RamClose
+};
+
+static RamEntryT *LookupEntry(const char *name) {
+  RamEntryT *entry;
+
+  TAILQ_FOREACH(entry, &RamDir, link) {
+    if (strcmp(name, entry->name) == 0)
+      return entry;
+  }
+
+  return NULL;
+}
+
+static void FreeEntry(RamEntryT *entry) {
+  MemFree(entry->data);
+  MemFree(entry);
+}
+
+FileT *RamOpen(const char *name asm("a0"), u_int flags asm("d0")) {
+  RamEntryT *entry;
+  FileT *f = NULL;
+
+  MutexLock(&RamMtx);
+
+  if (!(entry = LookupEntry(name))) {
+    if (flags & RAM_CREATE) {
+      u_int len = strlen(name) + 1;
+      entry = MemAlloc(sizeof(RamEntryT) + len, MEMF_PUBLIC|MEMF_CLEAR);
+      entry->attr = (flags & RAM_CHIP) ? MEMF_CHIP : MEMF_PUBLIC;
+      strlcpy(entry->name, name, len);
+      TAILQ_INSERT_TAIL(&RamDir, entry, link);
+      Debug("Created '%s'", name);
+    }
+  } else if (flags & RAM_TRUNC) {
+    entry->size = 0;
+  }
+
+  if (entry) {
+    f = MemAlloc(sizeof(FileT), MEMF_PUBLIC);
+    f->ops = &RamOps;
+    f->entry = entry;
+    f->pos = 0;
+    entry->refcnt++;
+  }
+
+  MutexUnlock(&RamMtx);
+
+  return f;
+}
+
+void RamDelete(const char *name asm("a0")) {
+  RamEntryT *entry;
+
+  MutexLock(&RamMtx);
+
+  if ((entry = LookupEntry(name))) {
+    TAILQ_REMOVE(&RamDir, entry, link);
+    /* Contents are released when the last file is closed. */
+    if (entry->refcnt)
+      entry->unlinked = true;
+    else
+      FreeEntry(entry);
+  }
+
+  MutexUnlock(&RamMtx);
+}
+
+static void RamClose(FileT *f) {
+  RamEntryT *entry = f->entry;
+
+  MutexLock(&RamMtx);
+  if (--entry->refcnt == 0 && entry->unlinked)
+    FreeEntry(entry);
+  MutexUnlock(&RamMtx);
+
+  MemFree(f);
+}
+
+static int RamRead(FileT *f, void *buf, u_int nbyte) {
+  RamEntryT *entry = f->entry;
+  int nread = 0;
+
+  Debug("$%p $%p %d+%d", f, buf, f->pos, nbyte);
+
+  if (f->pos < entry->size) {
+    nread = min(nbyte, entry->size - f->pos);
+    memcpy(buf, entry->data + f->pos, nread);
+    f->pos += nread;
+  }
+
+  return nread;
+}
+
+static int RamWrite(FileT *f, const void *buf, u_int nbyte) {
+  RamEntryT *entry = f->entry;
+  u_int end = f->pos + nbyte;
+
+  Debug("$%p $%p %d+%d", f, buf, f->pos, nbyte);
+
+  if (end > entry->capacity) {
+    /* Grow geometrically, so that many small writes don't move the block
+     * around on every call. */
+    u_int capacity = max(end, entry->capacity * 2);
+
+    if (entry->data == NULL)
+      entry->data = MemAlloc(capacity, entry->attr);
+    else
+      entry->data = MemResize(entry->data, capacity);
+
+    entry->capacity = capacity;
+  }
+
+  /* Fill the gap if the file was seeked beyond its end. */
+  if (f->pos > entry->size)
+    bzero(entry->data + entry->size, f->pos - entry->size);
+
+  memcpy(entry->data + f->pos, buf, nbyte);
+
+  f->pos = end;
+  if (end > entry->size)
+    entry->size = end;
+
+  return nbyte;
+}
+
+static int RamSeek(FileT *f, int offset, int whence) {
+  if (whence == SEEK_CUR) {
+    offset += f->pos;
+  } else if (whence == SEEK_END) {
+    offset += f->entry->size;
+  } else if (whence != SEEK_SET) {
+    return EINVAL;
+  }
+
+  /* Unlike in read-only files, position beyond the end is fine. */
+  if (offset < 0)
+    return EINVAL;
+
+  f->pos = offset;
+  return offset;
+}
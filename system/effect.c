@@ -1,6 +1,12 @@
 #include <custom.h>
 #include <effect.h>
+#include <linkerset.h>
 #include <system/cia.h>
+#include <system/blitstats.h>
+#include <system/interrupt.h>
+#include <system/replay.h>
+#include <system/sampler.h>
+#include <system/task.h>
 
 #define SHOW_MEMORY_STATS 0
 #define REMOTE_CONTROL 0
@@ -16,6 +22,41 @@ static void ShowMemStats(void) {
 # define ShowMemStats()
 #endif
 
+static u_char IsWaiting = 0;
+
+static void VBlankWakeupHandler(void) {
+  if (IsWaiting) {
+    IsWaiting = 0;
+    TaskNotifyISR(INTF_VERTB);
+  }
+}
+
+INTSERVER(VertBlankWakeup, 0, (IntFuncT)VBlankWakeupHandler, NULL);
+
+/* Puts a task into sleep waiting for VBlank interrupt. */
+void TaskWaitVBlank(void) {
+  IntrDisable();
+#ifdef BLITSTATS
+  BlitStatsWaitVBlank();
+#endif
+  IsWaiting = -1;
+  TaskWait(INTF_VERTB);
+  IntrEnable();
+}
+
+/* VBlank wakeup server is installed independently of main() routine, so that
+ * a program can provide its own main() and still use TaskWaitVBlank. */
+static void InitVBlankWakeup(void) {
+  AddIntServer(INTB_VERTB, VertBlankWakeup);
+}
+
+static void KillVBlankWakeup(void) {
+  RemIntServer(INTB_VERTB, VertBlankWakeup);
+}
+
+ADD2INIT(InitVBlankWakeup, 0);
+ADD2EXIT(KillVBlankWakeup, 0);
+
 #if REMOTE_CONTROL
 # include <system/file.h>
 static void SendEffectStatus(EffectT *effect) {
@@ -82,16 +123,52 @@ void EffectUnLoad(EffectT *effect) {
 }
 
 void EffectRun(EffectT *effect) {
+#ifdef BENCH
+  int dropped = 0;
+#endif
+
   SetFrameCounter(0);
+#ifdef SAMPLER
+  SamplerStart(SAMPLER);
+#endif
+#ifdef BLITSTATS
+  BlitStatsStart();
+#endif
 
   lastFrameCount = ReadFrameCounter();
 
   do {
     int t = ReadFrameCounter();
     exitLoop = LeftMouseButton();
+#ifdef REPLAY
+    exitLoop = !ReplayFrame(&t);
+#endif
+#ifdef RECORD
+    RecordFrame(t);
+#endif
+#ifdef BENCH
+    if (t >= BENCH)
+      exitLoop = true;
+    /* Previous frame took longer than one vertical blank period. */
+    if (t - lastFrameCount > 1)
+      dropped += t - lastFrameCount - 1;
+#endif
     frameCount = t;
     if (effect->Render)
       effect->Render();
+    /* Send a bit of binary log each frame, not to disturb the effect. */
+    LogDrain(64);
     lastFrameCount = t;
   } while (!exitLoop);
+
+#ifdef SAMPLER
+  SamplerStop();
+#endif
+#ifdef BLITSTATS
+  BlitStatsStop();
+#endif
+#ifdef BENCH
+  Log("[Bench] %s frames=%d dropped=%d\n", effect->name, frameCount, dropped);
+#endif
+  ProfilerDump();
 }
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <system/amigahunk.h>
+#include <system/buffile.h>
 #include <system/file.h>
 #include <system/memory.h>
 
@@ -19,6 +20,9 @@
 #define HUNKF_CHIP __BIT(30)
 #define HUNKF_FAST __BIT(31)
 
+/* Hunk file is mostly read a longword at a time, so read it in chunks. */
+#define HUNK_BUFSIZE 1024
+
 static long ReadLong(FileT *fh) {
   long v = 0;
   FileRead(fh, &v, sizeof(v));
@@ -113,14 +117,16 @@ static bool LoadHunks(FileT *fh, HunkT **hunkArray) {
   return true;
 }
 
-HunkT *LoadHunkList(FileT *fh) {
+HunkT *LoadHunkList(FileT *file) {
+  FileT *fh = BufOpen(file, HUNK_BUFSIZE);
   short hunkId = ReadLong(fh);
   int n, first, last, hunkCount;
   HunkT **hunkArray;
+  HunkT *hunkList = NULL;
 
   if (hunkId != HUNK_HEADER) {
     Log("Not an Amiga Hunk file!\n");
-    return NULL;
+    goto quit;
   }
 
   /* Skip resident library names. */
@@ -139,12 +145,14 @@ HunkT *LoadHunkList(FileT *fh) {
   hunkCount = last - first + 1;
   hunkArray = alloca(sizeof(HunkT *) * hunkCount);
 
-  if (AllocHunks(fh, hunkArray, hunkCount))
-    if (LoadHunks(fh, hunkArray))
-      return hunkArray[0];
+  if (AllocHunks(fh, hunkArray, hunkCount) && LoadHunks(fh, hunkArray))
+    hunkList = hunkArray[0];
+  else
+    FreeHunkList(hunkArray[0]);
 
-  FreeHunkList(hunkArray[0]);
-  return NULL;
+quit:
+  FileClose(fh);
+  return hunkList;
 }
 
 void FreeHunkList(HunkT *hunk) {
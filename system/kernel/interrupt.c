@@ -3,14 +3,6 @@
 #include <system/interrupt.h>
 #include <system/task.h>
 
-/* Interrupt Vector Entry */
-typedef struct IntVecEntry {
-  IntHandlerT code;
-  void *data;
-} IntVecEntryT;
-
-typedef IntVecEntryT IntVecT[INTB_INTEN];
-
 /* Amiga autovector interrupts table. */
 IntVecT IntVec;
 
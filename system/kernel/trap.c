@@ -83,5 +83,6 @@ void TrapHandler(TrapFrameT *frame) {
         (read ? "read" : "write"), addr);
   }
 
+  LogDrain(-1);
   PANIC();
 }
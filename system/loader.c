@@ -14,6 +14,7 @@
 #include <system/memfile.h>
 #include <system/memory.h>
 #include <system/task.h>
+#include <uae.h>
 
 u_char CpuModel = CPU_68000;
 
@@ -102,4 +103,9 @@ void Loader(BootDataT *bd) {
 #endif
   
   Log("[Loader] Shutdown complete!\n");
+  LogDrain(-1);
+
+#ifdef BENCH
+  UaeExit();
+#endif
 }
@@ -1,29 +1,9 @@
 #include <custom.h>
 #include <effect.h>
-#include <system/interrupt.h>
 #include <system/task.h>
 
 extern EffectT Effect;
 
-static u_char IsWaiting = 0;
-
-static void VBlankWakeupHandler(void) {
-  if (IsWaiting) {
-    IsWaiting = 0;
-    TaskNotifyISR(INTF_VERTB);
-  }
-}
-
-INTSERVER(VertBlankWakeup, 0, (IntFuncT)VBlankWakeupHandler, NULL);
-
-/* Puts a task into sleep waiting for VBlank interrupt. */
-void TaskWaitVBlank(void) {
-  IntrDisable();
-  IsWaiting = -1;
-  TaskWait(INTF_VERTB);
-  IntrEnable();
-}
-
 #define BGTASK 0
 
 #if BGTASK
@@ -52,15 +32,11 @@ int main(void) {
 
   StartBgTask();
 
-  AddIntServer(INTB_VERTB, VertBlankWakeup);
-
   EffectLoad(&Effect);
   EffectInit(&Effect);
   EffectRun(&Effect);
   EffectKill(&Effect);
   EffectUnLoad(&Effect);
 
-  RemIntServer(INTB_VERTB, VertBlankWakeup);
-
   return 0;
 }
@@ -0,0 +1,117 @@
+#include <debug.h>
+#include <effect.h>
+#include <system/amigahunk.h>
+#include <system/autoinit.h>
+#include <system/file.h>
+#include <system/filesys.h>
+#include <system/memory.h>
+#include <system/part.h>
+#include <system/task.h>
+
+/* Placed at the beginning of first code hunk by crt0-part.S */
+typedef struct PartHeader {
+  EffectT *effect;
+  FuncItemSetT *initList;
+  FuncItemSetT *exitList;
+} PartHeaderT;
+
+static inline PartHeaderT *PartHeader(PartT *part) {
+  return (PartHeaderT *)part->hunks->data;
+}
+
+bool PartLoad(PartT *part) {
+  FileT *file;
+
+  if (part->hunks)
+    return true;
+
+  Log("[Part] Reading '%s'\n", part->path);
+
+  if (!(file = OpenFile(part->path))) {
+    Log("[Part] '%s' not found!\n", part->path);
+    return false;
+  }
+
+  part->hunks = LoadHunkList(file);
+  FileClose(file);
+
+  if (!part->hunks)
+    return false;
+
+  LogHunks(part->path, part->hunks);
+
+  {
+    PartHeaderT *hdr = PartHeader(part);
+    part->effect = hdr->effect;
+    CallFuncList(hdr->initList);
+  }
+
+  EffectLoad(part->effect);
+  return true;
+}
+
+void PartUnLoad(PartT *part) {
+  if (!part->hunks)
+    return;
+
+  EffectUnLoad(part->effect);
+  CallFuncList(PartHeader(part)->exitList);
+
+  Log("[Part] Freeing '%s'\n", part->path);
+
+  FreeHunkList(part->hunks);
+  part->hunks = NULL;
+  part->effect = NULL;
+}
+
+void PartRun(PartT *part) {
+  if (!PartWait(part))
+    return;
+
+  EffectInit(part->effect);
+  EffectRun(part->effect);
+  EffectKill(part->effect);
+}
+
+static PartT *volatile PendingPart = NULL;
+
+/* Background task has lower priority than main task, so it only gets the
+ * processor when an effect sleeps in TaskWaitVBlank. */
+static void PartLoaderLoop(__unused void *ptr) {
+  for (;;) {
+    PartT *part = PendingPart;
+    if (part) {
+      (void)PartLoad(part);
+      part->loading = false;
+      PendingPart = NULL;
+    } else {
+      TaskWaitVBlank();
+    }
+  }
+}
+
+void PartLoadAsync(PartT *part) {
+  static __aligned(8) char stack[1024];
+  static TaskT LoaderTask;
+
+  if (part->hunks)
+    return;
+
+  /* Only one part can be loaded in background at a time. */
+  while (PendingPart)
+    TaskWaitVBlank();
+
+  if (LoaderTask.name[0] == '\0') {
+    TaskInit(&LoaderTask, "part-loader", stack, sizeof(stack));
+    TaskRun(&LoaderTask, 1, PartLoaderLoop, NULL);
+  }
+
+  part->loading = true;
+  PendingPart = part;
+}
+
+bool PartWait(PartT *part) {
+  while (part->loading)
+    TaskWaitVBlank();
+  return PartLoad(part);
+}
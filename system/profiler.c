@@ -1,28 +1,121 @@
 #include <debug.h>
 #include <common.h>
 #include <effect.h>
+#include <stdlib.h>
+#include <custom.h>
 #include <system/cia.h>
 
+#define PROFILE_MASK (PROFILE_FRAMES - 1)
+#define MAX_DEPTH 8
+
+static ProfileT *ProfileCurrent = NULL;
+static ProfileT *ProfileList = NULL;
+static ProfileT **ProfileLast = &ProfileList;
+
+#ifdef RASTERBARS
+/* Bright and saturated, so that bars are not mistaken for effect's pixels.
+ * Color 0 is written by the CPU, so a copper list that reloads it hides
+ * the bars on lines following the copper move. */
+static const u_short RasterColor[16] = {
+  0xf00, 0x0f0, 0x00f, 0xff0, 0x0ff, 0xf0f, 0xf80, 0x8f0,
+  0x0f8, 0x08f, 0x80f, 0xf08, 0xfff, 0xf88, 0x8f8, 0x88f,
+};
+static u_short RasterColorNext = 0;
+
+static void SetRasterColor(ProfileT *prof) {
+  custom->color[0] = prof ? prof->color : 0;
+}
+#else
+#define SetRasterColor(prof) ((void)0)
+#endif
+
 void _ProfilerStart(ProfileT *prof asm("a0")) {
-  prof->lines = ReadLineCounter();
+  /* Register scope on its first use since last dump. */
+  if (prof->next == NULL && ProfileLast != &prof->next) {
+    *ProfileLast = prof;
+    ProfileLast = &prof->next;
+  }
+
+#ifdef RASTERBARS
+  if (prof->color == 0)
+    prof->color = RasterColor[RasterColorNext++ & 15];
+#endif
+
+  prof->parent = ProfileCurrent;
+  ProfileCurrent = prof;
+  SetRasterColor(prof);
+  prof->start = ReadLineCounter();
 }
 
 void _ProfilerStop(ProfileT *prof asm("a0")) {
-  u_short lines = ReadLineCounter() - prof->lines;
+  u_int lines = (ReadLineCounter() - prof->start) & 0xffffff;
+  u_short *sample;
+
+  ProfileCurrent = prof->parent;
+  SetRasterColor(ProfileCurrent);
+
+  /* Scope can be entered many times a frame, so sum up all the samples. */
+  if (prof->frame != frameCount) {
+    prof->frame = frameCount;
+    sample = &prof->history[prof->count++ & PROFILE_MASK];
+    *sample = 0;
+  } else {
+    sample = &prof->history[(prof->count - 1) & PROFILE_MASK];
+  }
+
+  lines += *sample;
+  *sample = min(lines, 65535U);
+}
+
+static int CompareSample(const void *a, const void *b) {
+  return *(const u_short *)a - *(const u_short *)b;
+}
+
+static void DumpScopes(ProfileT *parent, short depth) {
+  static const char indent[] = "                ";
+  ProfileT *prof;
+
+  for (prof = ProfileList; prof; prof = prof->next) {
+    u_short *sorted = prof->history;
+    short n;
+
+    if (prof->parent != parent)
+      continue;
+
+    n = min(prof->count, (u_int)PROFILE_FRAMES);
+    if (n == 0)
+      continue;
+
+    qsort(sorted, n, sizeof(u_short), CompareSample);
+
+    Log("[Profiler] %s%s: %d/%d/%d\n",
+        indent + sizeof(indent) - 1 - depth * 2, prof->name,
+        sorted[n / 2], sorted[div16(n * 95, 100)], sorted[n - 1]);
+
+    if (depth < MAX_DEPTH)
+      DumpScopes(prof, depth + 1);
+  }
+}
+
+/* Print percentiles of all scopes in one go and start from scratch. */
+void ProfilerDump(void) {
+  ProfileT *prof, *next;
 
-  if (lines > 32767)
-    lines = -lines;
+  if (ProfileList == NULL)
+    return;
 
-  if (lines < prof->min)
-    prof->min = lines;
-  if (lines > prof->max)
-    prof->max = lines;
+  Log("[Profiler] Raster lines per frame (p50/p95/max):\n");
+  DumpScopes(NULL, 0);
 
-  prof->total += lines;
-  prof->count++;
+  /* Scopes may live in a part that is going to be unloaded. */
+  for (prof = ProfileList; prof; prof = next) {
+    next = prof->next;
+    prof->next = NULL;
+    prof->count = 0;
+    prof->frame = -1;
+  }
 
-  /* Report every second! */
-  if (div16(lastFrameCount, 50) < div16(frameCount, 50))
-    Log("%s took %d-%d-%d (min-avg-max) raster lines.\n",
-        prof->name, prof->min, div16(prof->total, prof->count), prof->max);
+  ProfileList = NULL;
+  ProfileLast = &ProfileList;
+  ProfileCurrent = NULL;
 }
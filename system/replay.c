@@ -0,0 +1,58 @@
+#include <debug.h>
+#include <string.h>
+#include <system/event.h>
+#include <system/replay.h>
+
+#ifdef RECORD
+void RecordFrame(int frame) {
+  Log("[Record] T %d\n", frame);
+}
+
+/* EventT is three longwords long. */
+void RecordEvent(EventT *event) {
+  u_int *data = (u_int *)event;
+  Log("[Record] E %08x %08x %08x\n", data[0], data[1], data[2]);
+}
+#endif
+
+#ifdef REPLAY
+/*
+ * Replay data generated by tools/replay.py is a sequence of entries:
+ * frame counter value (two words), number of events and raw EventT
+ * structures. Each EffectRun session is terminated by REPLAY_STOP and
+ * the whole sequence by REPLAY_END marker.
+ */
+#define REPLAY_STOP 0x8000
+#define REPLAY_END 0xffff
+
+extern u_short ReplayData[];
+
+static u_short *ReplayPtr = ReplayData;
+
+bool ReplayFrame(int *frame) {
+  u_short *ptr = ReplayPtr;
+  short n;
+
+  if (ptr[0] == REPLAY_END)
+    return false;
+
+  *frame = (ptr[0] << 16) | ptr[1];
+  n = ptr[2];
+  ptr += 3;
+
+  while (--n >= 0) {
+    EventT event;
+    memcpy(&event, ptr, sizeof(EventT));
+    PushEvent(&event);
+    ptr += sizeof(EventT) / sizeof(u_short);
+  }
+
+  if (ptr[0] == REPLAY_STOP) {
+    ReplayPtr = ptr + 2;
+    return false;
+  }
+
+  ReplayPtr = ptr;
+  return ptr[0] != REPLAY_END;
+}
+#endif
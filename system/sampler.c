@@ -0,0 +1,104 @@
+#include <debug.h>
+#include <stdlib.h>
+#include <system/amigahunk.h>
+#include <system/exception.h>
+#include <system/memory.h>
+#include <system/sampler.h>
+#include <system/task.h>
+#include <system/timer.h>
+
+typedef struct Sample {
+  u_int pc;
+  TaskT *task;
+} SampleT;
+
+extern void AmigaLvl6Handler(void);
+extern void SamplerLvl6Handler(void);
+
+/* Set by SamplerLvl6Handler on entry to each level 6 interrupt. */
+u_int SamplerPC;
+
+static CIATimerT *SamplerTimer;
+static SampleT *Samples;
+static u_short SampleCount;
+static u_short SampleRate;
+
+static void SamplerTick(CIATimerT *timer __unused) {
+  if (SampleCount < SAMPLER_SIZE) {
+    SampleT *sample = &Samples[SampleCount++];
+    sample->pc = SamplerPC;
+    sample->task = CurrentTask;
+  }
+}
+
+void SamplerStart(u_short rate asm("d0")) {
+  /* Only CIA-B timers generate level 6 interrupts. */
+  if (!(SamplerTimer = AcquireTimer(TIMER_CIAB_B)) &&
+      !(SamplerTimer = AcquireTimer(TIMER_CIAB_A))) {
+    Log("[Sampler] No CIA-B timer available!\n");
+    return;
+  }
+
+  Samples = MemAlloc(sizeof(SampleT) * SAMPLER_SIZE, MEMF_PUBLIC);
+  SampleCount = 0;
+  SampleRate = rate;
+
+  IntrDisable();
+  ExcVec[EXC_INTLVL(6)] = SamplerLvl6Handler;
+  IntrEnable();
+
+  /* Timer is in continuous mode, so it's reloaded automatically. */
+  SetupTimer(SamplerTimer, SamplerTick, E_CLOCK / rate, 0);
+}
+
+static int CompareSample(const void *a, const void *b) {
+  const SampleT *sa = a;
+  const SampleT *sb = b;
+  if (sa->task != sb->task)
+    return (sa->task < sb->task) ? -1 : 1;
+  if (sa->pc != sb->pc)
+    return (sa->pc < sb->pc) ? -1 : 1;
+  return 0;
+}
+
+void SamplerStop(void) {
+  HunkT *hunk;
+  TaskT *task = NULL;
+  short i, j;
+
+  if (!SamplerTimer)
+    return;
+
+  ReleaseTimer(SamplerTimer);
+  SamplerTimer = NULL;
+
+  IntrDisable();
+  ExcVec[EXC_INTLVL(6)] = AmigaLvl6Handler;
+  IntrEnable();
+
+  Log("[Sampler] %d samples at %d Hz\n", SampleCount, SampleRate);
+
+  /* Tell the host where the executable was loaded. */
+  for (hunk = (HunkT *)ExcVec[1]; hunk; hunk = hunk->next)
+    Log("[Sampler] segment $%08x\n", (u_int)hunk->data);
+
+  qsort(Samples, SampleCount, sizeof(SampleT), CompareSample);
+
+  for (i = 0; i < SampleCount; i = j) {
+    SampleT *sample = &Samples[i];
+
+    if (sample->task != task) {
+      task = sample->task;
+      Log("[Sampler] task $%08x %s\n", (u_int)task, task->name);
+    }
+
+    for (j = i + 1; j < SampleCount; j++)
+      if (CompareSample(sample, &Samples[j]))
+        break;
+
+    Log("[Sampler] $%08x $%08x %d\n", (u_int)task, sample->pc, j - i);
+  }
+
+  MemFree(Samples);
+  Samples = NULL;
+}
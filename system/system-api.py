@@ -30,9 +30,19 @@ SIZEOF = {
 }
 
 
-def doit(api, sc, jv):
+# Returns system calls and shared variables with their addresses. Also used by
+# tools that need to know where shared variables live (e.g. capture.py).
+#
+# System calls may be put between preprocessor conditionals, which are passed
+# to generated files along with system call entries (directive is returned in
+# place of name, with no address). Each branch of a conditional starts at the
+# same address, so addresses of entries that follow it don't depend on build
+# configuration.
+def parse(api):
     syscalls = []
     shvars = []
+    branches = []
+    index = 0
 
     for i, line in enumerate(map(str.strip, api)):
         if not line:
@@ -40,14 +50,27 @@ def doit(api, sc, jv):
         if line.startswith(';'):
             continue
         fs = line.split()
-        if fs[0] == 'syscall' and len(fs) == 2:
-            syscalls.append(fs[1])
-        elif fs[0] == 'shvar' and len(fs) == 3:
+        if fs[0] in ['#if', '#ifdef', '#ifndef']:
+            branches.append([index, index])
+            syscalls.append((line, None))
+        elif fs[0] in ['#elif', '#else'] and branches:
+            branches[-1][1] = max(branches[-1][1], index)
+            index = branches[-1][0]
+            syscalls.append((line, None))
+        elif fs[0] == '#endif' and branches:
+            index = max(branches.pop()[1], index)
+            syscalls.append((line, None))
+        elif fs[0] == 'syscall' and len(fs) == 2:
+            syscalls.append((fs[1], index * 6 + 0xc0))
+            index += 1
+        elif fs[0] == 'shvar' and len(fs) == 3 and not branches:
             shvars.append([fs[1], fs[2]])
         else:
             raise SystemExit(f'line {i+1}: syntax error: {line}')
 
-    syscalls = [(name, i * 6 + 0xc0) for i, name in enumerate(syscalls)]
+    if branches:
+        raise SystemExit('missing #endif')
+
     shvars_sorted = sorted(shvars, key=lambda x: -SIZEOF.get(x[1]))
     shvars = []
 
@@ -56,6 +79,12 @@ def doit(api, sc, jv):
         addr -= SIZEOF.get(typ)
         shvars.append((name, addr, typ))
 
+    return syscalls, shvars
+
+
+def doit(api, sc, jv):
+    syscalls, shvars = parse(api)
+
     with redirect_stdout(sc):
         print("#include <asm.h>")
         print("#include <stab.h>")
@@ -67,6 +96,9 @@ def doit(api, sc, jv):
         print()
         print('\t# system calls')
         for name, addr in syscalls:
+            if addr is None:
+                print(name)
+                continue
             print(f'\t.set\t_L(_{name}), 0x{addr:x}')
             print(f'\t.stabs\t__STRING(_L(_{name})),'
                   f' N_ABS|N_EXT, 0, 0, 0x{addr:x}')
@@ -86,8 +118,11 @@ def doit(api, sc, jv):
         print("#include <asm.h>")
         print()
         print(f"ENTRY(JumpTable)")
-        for name, _ in syscalls:
-            print(f"\tjmp\t_L({name})")
+        for name, addr in syscalls:
+            if addr is None:
+                print(name)
+            else:
+                print(f"\tjmp\t_L({name})")
         print(f"END(JumpTable)")
         print()
         print("\t.set\t_L(JumpTableSize), . - _L(JumpTable)")
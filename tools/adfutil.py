@@ -2,11 +2,12 @@
 
 import argparse
 import os
+import zlib
 from array import array
 from struct import pack
 from io import BytesIO
 
-from fsutil import SECTOR, write_pad, sectors, Filesystem
+from fsutil import SECTOR, align, write_pad, sectors, Filesystem
 
 #
 # On disk format description:
@@ -14,14 +15,43 @@ from fsutil import SECTOR, write_pad, sectors, Filesystem
 # sector 0..1: bootblock
 #  [LONG] 'DOS\0'
 #  [LONG] checksum
+#  [WORD] length of executable file, sector aligned, shifted right by 8
 #  [WORD] start of executable file, sector aligned, shifted right by 8
-#  [WORD] offset of executable file, sector aligned, shifte right by 8
+#  [WORD] unpacked length of executable file, sector aligned, shifted right
+#         by 8, or zero if executable file is not compressed
 #  ...    boot code
 #
 # sector 2..: file system image
 #
+# If executable file is compressed, then length and start describe
+# the decompressing loader, that is placed after file system image and is
+# immediately followed by the compressed executable file image:
+#  for each chunk (2-byte aligned):
+#   [LONG] size of deflate stream (including padding)
+#   [LONG] size of data after decompression
+#   ...    raw deflate stream
+#  [LONG] 0 : marks the end of chunk list
+#  [LONG] 0
+#
+
+TRACK = SECTOR * 11
+FLOPPY = TRACK * 80 * 2
+
+# Each chunk can be inflated as soon as it's been read from the disk.
+CHUNK = 16384
 
-FLOPPY = SECTOR * 80 * 11 * 2
+
+def compress(data):
+    packed = BytesIO()
+    for i in range(0, len(data), CHUNK):
+        comp = zlib.compressobj(9, zlib.DEFLATED, -15)
+        stream = comp.compress(data[i:i + CHUNK]) + comp.flush()
+        if len(stream) & 1:
+            stream += b'\0'
+        packed.write(pack('>II', len(stream), len(data[i:i + CHUNK])))
+        packed.write(stream)
+    packed.write(pack('>II', 0, 0))
+    return packed.getvalue()
 
 
 def checksum(data):
@@ -32,12 +62,11 @@ def checksum(data):
     return (~chksum & 0xffffffff)
 
 
-def write_bb(adf, bootcode, exe):
+def write_bb(adf, bootcode, exe_start, exe_length, exe_unpacked=0):
     boot = BytesIO(bootcode)
     # Overwrite boot block header
-    exe_start = sectors(exe.offset) + 2
-    exe_length = sectors(exe.size)
-    boot.write(pack('>4s4xHH', b'DOS\0', exe_length * 2, exe_start * 2))
+    boot.write(pack('>4s4xHHH', b'DOS\0',
+                    exe_length * 2, exe_start * 2, exe_unpacked * 2))
     # Move to the end and pad it so it takes 2 sectors
     boot.seek(0, os.SEEK_END)
     write_pad(boot, 2 * SECTOR)
@@ -49,12 +78,28 @@ def write_bb(adf, bootcode, exe):
     adf.write(boot.getvalue())
 
 
+def make_packed(loader, exe):
+    loader = BytesIO(loader)
+    # Decompressing loader must be padded to sector boundary,
+    # since compressed image is read right after it.
+    loader.seek(0, os.SEEK_END)
+    write_pad(loader)
+    # Fill in the size of compressed image
+    packed = compress(exe.data)
+    loader.seek(4, os.SEEK_SET)
+    loader.write(pack('>I', len(packed)))
+    return loader.getvalue(), packed
+
+
 if __name__ == '__main__':
     parser = argparse.ArgumentParser(
         description='Create ADF file from file system image.')
     parser.add_argument(
         '-b', '--bootcode', metavar='BOOTCODE', type=str,
         help='Code to be put into boot block')
+    parser.add_argument(
+        '-i', '--inflate', metavar='LOADER', type=str,
+        help='Decompressing loader - makes executable file compressed')
     parser.add_argument(
         'image', metavar='IMAGE', type=str,
         help='File system image file')
@@ -65,6 +110,7 @@ if __name__ == '__main__':
 
     bootblock = ''
     executable = None
+    inflate = None
 
     if args.bootcode:
         if not os.path.isfile(args.bootcode):
@@ -78,13 +124,40 @@ if __name__ == '__main__':
         if not executable:
             raise SystemExit('No AmigaHunk executable found!')
 
+    if args.inflate:
+        if not args.bootcode:
+            raise SystemExit('Decompressing loader requires boot code!')
+        if not os.path.isfile(args.inflate):
+            raise SystemExit('Decompressing loader file does not exists!')
+        with open(args.inflate, 'rb') as fh:
+            inflate = fh.read()
+
     with open(args.adf, 'wb') as adf:
-        if bootblock:
-            write_bb(adf, bootblock, executable)
+        with open(args.image, 'rb') as img:
+            image = img.read()
+
+        if inflate:
+            loader, packed = make_packed(inflate, executable)
+            loader_start = sectors(len(image)) + 2
+            # Loader reads whole tracks, so they must fit on the floppy.
+            packed_end = loader_start * SECTOR + len(loader) + align(
+                len(packed), TRACK)
+            if packed_end > FLOPPY:
+                raise SystemExit('Compressed executable does not fit!')
+            write_bb(adf, bootblock, loader_start, sectors(len(loader)),
+                     sectors(executable.size))
+        elif bootblock:
+            write_bb(adf, bootblock, sectors(executable.offset) + 2,
+                     sectors(executable.size))
 
         # Write file system image
-        with open(args.image, 'rb') as img:
-            adf.write(img.read())
+        adf.write(image)
+
+        # Append decompressing loader and compressed executable file image
+        if inflate:
+            write_pad(adf)
+            adf.write(loader)
+            adf.write(packed)
 
         # Complete floppy disk image
         write_pad(adf, FLOPPY)
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+
+import argparse
+import csv
+import os.path
+import re
+import subprocess
+import sys
+
+
+def HerePath(*components):
+    return os.path.join(os.path.dirname(os.path.realpath(__file__)), '..',
+                        *components)
+
+
+BENCH_RE = re.compile(r'\[Bench\] (\S+) frames=(\d+) dropped=(\d+)')
+PROFILE_RE = re.compile(r'\[Profiler\] ( *)(\S+): (\d+)/(\d+)/(\d+)')
+
+
+def run(emulator, effect, timeout):
+    name = os.path.basename(os.path.normpath(effect))
+    rom = os.path.join(effect, name + '.rom')
+    adf = os.path.join(effect, name + '.adf')
+
+    cmd = [emulator,
+           '--kickstart_file=' + os.path.realpath(rom),
+           '--floppy_drive_0=' + os.path.realpath(adf),
+           '--headless=1', '--warp_mode=1', '--console_debugger=0',
+           '--stdout=1', HerePath('effects', 'Config.fs-uae')]
+
+    try:
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE,
+                              stderr=subprocess.DEVNULL, timeout=timeout)
+        output = proc.stdout
+    except subprocess.TimeoutExpired as ex:
+        print('%s: timed out after %d seconds!' % (name, timeout),
+              file=sys.stderr)
+        output = ex.stdout or b''
+
+    return parse(name, output.decode(errors='replace').splitlines())
+
+
+# Profiler scopes are printed as a tree with two spaces of indentation per
+# level. Nested scope name is a path from the root, i.e. Render/Transform.
+def parse(name, lines):
+    results = {}
+    scopes = []
+    effect = name
+
+    # Profiler results are reported right after each effect finishes.
+    for line in lines:
+        m = BENCH_RE.search(line)
+        if m:
+            effect = m.group(1)
+            results[effect, 'frames'] = int(m.group(2))
+            results[effect, 'dropped'] = int(m.group(3))
+            continue
+
+        m = PROFILE_RE.search(line)
+        if m:
+            depth = len(m.group(1)) // 2
+            scopes[depth:] = [m.group(2)]
+            scope = '/'.join(scopes)
+            for suffix, value in zip(['p50', 'p95', 'max'], m.group(3, 4, 5)):
+                results[effect, scope + '.' + suffix] = int(value)
+
+    if not results:
+        print('%s: no benchmark results!' % name, file=sys.stderr)
+
+    return results
+
+
+def compare(results, baseline, tolerance):
+    regressions = 0
+
+    for key, old in sorted(baseline.items()):
+        new = results.get(key)
+        if new is None:
+            print('%s %s: missing!' % key)
+            regressions += 1
+        elif new > old * (100 + tolerance) / 100 and new > old + 1:
+            print('%s %s: %d -> %d' % (key + (old, new)))
+            regressions += 1
+
+    for key in sorted(results.keys() - baseline.keys()):
+        print('%s %s: new measurement %d' % (key + (results[key],)))
+
+    return regressions
+
+
+def read_csv(path):
+    with open(path, newline='') as f:
+        return {(row['effect'], row['metric']): int(row['value'])
+                for row in csv.DictReader(f)}
+
+
+def write_csv(path, results):
+    with open(path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['effect', 'metric', 'value'])
+        for (effect, metric), value in sorted(results.items()):
+            writer.writerow([effect, metric, value])
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Run effects in headless FS-UAE and collect timings.')
+    parser.add_argument('-e', '--emulator', type=str, default='fs-uae',
+                        help='Path to FS-UAE emulator binary.')
+    parser.add_argument('-t', '--timeout', type=int, default=120,
+                        help='Time limit for each effect in seconds.')
+    parser.add_argument('-b', '--baseline', type=str,
+                        help='CSV file with reference results.')
+    parser.add_argument('-p', '--tolerance', type=int, default=5,
+                        help='Acceptable slowdown in percents.')
+    parser.add_argument('-o', '--output', type=str, default='bench.csv',
+                        help='CSV file to store results in.')
+    parser.add_argument('effects', metavar='DIR', type=str, nargs='+',
+                        help='Directories of effects to benchmark.')
+    args = parser.parse_args()
+
+    results = {}
+    for effect in args.effects:
+        print('Running %s...' % effect, file=sys.stderr)
+        results.update(run(args.emulator, effect, args.timeout))
+
+    write_csv(args.output, results)
+
+    if not args.baseline:
+        raise SystemExit(0)
+
+    baseline = {}
+    if os.path.isfile(args.baseline):
+        baseline = read_csv(args.baseline)
+
+    if not baseline:
+        print('%s: no reference results, comparison skipped!' % args.baseline,
+              file=sys.stderr)
+    elif compare(results, baseline, args.tolerance):
+        raise SystemExit('Performance regressions found!')
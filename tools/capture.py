@@ -0,0 +1,310 @@
+#!/usr/bin/env python3
+
+import argparse
+import asyncio
+import importlib.util
+import os.path
+
+from PIL import Image, ImageChops
+
+from debug.uae import UaeProcess, CUSTOM_SIZE
+
+
+def HerePath(*components):
+    return os.path.join(os.path.dirname(os.path.realpath(__file__)), '..',
+                        *components)
+
+
+def SystemApi():
+    path = HerePath('system', 'system-api.py')
+    spec = importlib.util.spec_from_file_location('system_api', path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+# Layout of shared variables is taken from the script that generates it.
+def SharedVariable(name):
+    with open(HerePath('system', 'system-api.in')) as api:
+        _, shvars = SystemApi().parse(api)
+
+    for var, addr, _ in shvars:
+        if var == name:
+            return addr
+    raise SystemExit('Shared variable "%s" not found!' % name)
+
+
+BPLCON0 = 0x100
+BPL1MOD = 0x108
+BPL2MOD = 0x10a
+BPLPT = 0x0e0
+COLOR = 0x180
+COP1LC = 0x080
+COP2LC = 0x084
+COPJMP1 = 0x088
+COPJMP2 = 0x08a
+DDFSTRT = 0x092
+DDFSTOP = 0x094
+DIWSTRT = 0x08e
+DIWSTOP = 0x090
+
+BPLCON0_HIRES = 0x8000
+BPLCON0_HAM = 0x0800
+
+LASTHP = 0xe2
+LINES = 313
+PAGE = 4096
+
+
+class Memory():
+    def __init__(self, uae):
+        self.uae = uae
+        self.pages = {}
+
+    async def page(self, addr):
+        data = self.pages.get(addr)
+        if data is None:
+            data = bytes.fromhex(await self.uae.read_memory(addr, PAGE))
+            self.pages[addr] = data
+        return data
+
+    async def read(self, addr, size):
+        data = b''
+        while size > 0:
+            base = addr & ~(PAGE - 1)
+            n = min(size, base + PAGE - addr)
+            data += (await self.page(base))[addr - base:addr - base + n]
+            addr += n
+            size -= n
+        return data
+
+    async def word(self, addr):
+        return int.from_bytes(await self.read(addr, 2), 'big')
+
+
+class Copper():
+    def __init__(self, memory, regs):
+        self.memory = memory
+        self.cop = {reg: regs[reg] for reg in range(COP1LC, COPJMP1, 2)}
+        self.pc = Long(regs, COP1LC)
+        self.wait = None
+        self.stopped = False
+
+    # Executes instructions until copper waits for beam position past
+    # the end of given line. Returns register writes as (hpos, reg, value).
+    async def run(self, line):
+        writes = []
+        h = 0
+
+        while not self.stopped:
+            if self.wait:
+                vp, hp, vm, hm = self.wait
+                beam = ((line & 0xff) << 8) | LASTHP
+                if (beam & (vm << 8 | hm)) < ((vp << 8 | hp) & (vm << 8 | hm)):
+                    break
+                if (line & 0xff & vm) == (vp & vm):
+                    h = max(h, hp & hm)
+                self.wait = None
+
+            ir1 = await self.memory.word(self.pc)
+            ir2 = await self.memory.word(self.pc + 2)
+            self.pc += 4
+            h += 4
+
+            if ir1 & 1 == 0:
+                reg = ir1 & 0x1fe
+                writes.append((h, reg, ir2))
+                if COP1LC <= reg < COPJMP1:
+                    self.cop[reg] = ir2
+                elif reg == COPJMP1:
+                    self.pc = Long(self.cop, COP1LC)
+                elif reg == COPJMP2:
+                    self.pc = Long(self.cop, COP2LC)
+            elif ir1 == 0xffff and ir2 == 0xfffe:
+                self.stopped = True
+            elif ir2 & 1 == 0:
+                self.wait = (ir1 >> 8, ir1 & 0xfe,
+                             (ir2 >> 8) | 0x80, ir2 & 0xfe)
+            # SKIP is not supported - the next instruction is always executed.
+
+        return writes
+
+
+def Color(rgb):
+    return ((rgb >> 8) & 15) * 17, ((rgb >> 4) & 15) * 17, (rgb & 15) * 17
+
+
+def Decode(pixels, palette, bplcon0):
+    depth = (bplcon0 >> 12) & 7
+    ham = bplcon0 & BPLCON0_HAM and depth >= 5
+    output = []
+    last = Color(palette[0][1][0])
+
+    # Palette is a list of changes as (pixel, colors).
+    for x, p in enumerate(pixels):
+        while len(palette) > 1 and palette[1][0] <= x:
+            palette.pop(0)
+        colors = palette[0][1]
+        if ham:
+            r, g, b = last
+            c = (p & 15) * 17
+            if p >> 4 == 0:
+                last = Color(colors[p & 15])
+            elif p >> 4 == 1:
+                last = (r, g, c)
+            elif p >> 4 == 2:
+                last = (c, g, b)
+            else:
+                last = (r, c, b)
+            output.append(last)
+        elif p >= 32:
+            output.append(tuple(c // 2 for c in Color(colors[p - 32])))
+        else:
+            output.append(Color(colors[p]))
+    return output
+
+
+def Long(regs, reg):
+    return (regs[reg] << 16) | regs[reg + 2]
+
+
+async def Render(memory, regs):
+    copper = Copper(memory, regs)
+    pointers = [Long(regs, BPLPT + i * 4) for i in range(6)]
+    rows = []
+    width = 0
+
+    def apply(writes):
+        for h, reg, value in writes:
+            regs[reg] = value
+            if BPLPT <= reg < BPLPT + 24:
+                i = (reg - BPLPT) // 4
+                pointers[i] = Long(regs, BPLPT + i * 4)
+
+    for line in range(LINES):
+        bplcon0 = regs[BPLCON0]
+        hires = bool(bplcon0 & BPLCON0_HIRES)
+        hstart = regs[DIWSTRT] & 0xff
+        ddfstrt = regs[DDFSTRT] & 0xfc
+
+        writes = await copper.run(line)
+
+        # Palette changes are tracked with pixel accuracy. One color clock
+        # lasts two lores or four hires pixels.
+        colors = [regs[COLOR + i * 2] for i in range(32)]
+        palette = [(0, list(colors))]
+        for h, reg, value in writes:
+            if COLOR <= reg < COLOR + 64:
+                x = max(0, (2 * h - hstart) * (2 if hires else 1))
+                colors[(reg - COLOR) // 2] = value
+                palette.append((x, list(colors)))
+
+        # Other register writes that happen before bitplane fetch starts
+        # affect current line, the rest is applied after the line is fetched.
+        apply([w for w in writes if w[0] < ddfstrt])
+
+        vstart = regs[DIWSTRT] >> 8
+        vstop = regs[DIWSTOP] >> 8
+        if not regs[DIWSTOP] & 0x8000:
+            vstop |= 0x100
+
+        if vstart <= line < vstop:
+            bplcon0 = regs[BPLCON0]
+            depth = min((bplcon0 >> 12) & 7, 6)
+            unit = 4 if bplcon0 & BPLCON0_HIRES else 8
+            ddfstrt = regs[DDFSTRT] & 0xfc
+            ddfstop = regs[DDFSTOP] & 0xfc
+            words = max(0, (ddfstop - ddfstrt + 8) // unit)
+            width = max(width, words * 16)
+
+            pixels = [0] * (words * 16)
+            for i in range(depth):
+                data = await memory.read(pointers[i], words * 2)
+                bits = int.from_bytes(data, 'big')
+                for x in range(words * 16):
+                    if bits & (1 << (words * 16 - 1 - x)):
+                        pixels[x] |= 1 << i
+                modulo = regs[BPL2MOD if i & 1 else BPL1MOD]
+                modulo -= (modulo & 0x8000) << 1
+                pointers[i] = (pointers[i] + words * 2 + modulo) & 0xfffffe
+
+            rows.append(Decode(pixels, palette, bplcon0))
+
+        apply([w for w in writes if w[0] >= ddfstrt])
+
+    image = Image.new('RGB', (width, len(rows)))
+    for y, row in enumerate(rows):
+        for x, rgb in enumerate(row):
+            image.putpixel((x, y), rgb)
+    return image
+
+
+async def Capture(args):
+    uae = UaeProcess(
+        await asyncio.create_subprocess_exec(
+            args.emulator,
+            '--kickstart_file=' + os.path.realpath(args.rom),
+            '--floppy_drive_0=' + os.path.realpath(args.floppy),
+            '--use_debugger=1', '--warp_mode=1',
+            HerePath('effects', 'Config.fs-uae'),
+            stdin=asyncio.subprocess.PIPE,
+            stdout=asyncio.subprocess.DEVNULL,
+            stderr=asyncio.subprocess.PIPE))
+
+    frameCount = SharedVariable('frameCount')
+
+    await uae.prologue()
+    await uae.insert_watchpoint(frameCount, 4, 'W')
+
+    # Effect writes frame counter once per frame, so check it each time.
+    while True:
+        uae.resume()
+        await uae.prologue()
+        if await uae.read_long(frameCount) >= args.frame:
+            break
+
+    await uae.remove_watchpoint(frameCount, 4, 'W')
+
+    custom = bytes.fromhex(await uae.read_custom(0, CUSTOM_SIZE))
+    regs = {i: int.from_bytes(custom[i:i + 2], 'big')
+            for i in range(0, CUSTOM_SIZE, 2)}
+
+    image = await Render(Memory(uae), regs)
+
+    await uae.kill()
+    await uae.wait()
+    return image
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Capture a frame displayed by an effect to PNG file.')
+    parser.add_argument('-e', '--emulator', type=str, default='fs-uae',
+                        help='Path to FS-UAE emulator binary.')
+    parser.add_argument('-r', '--rom', type=str, required=True,
+                        help='Kickstart ROM image with the effect.')
+    parser.add_argument('-f', '--floppy', type=str, required=True,
+                        help='Floppy disk image with the effect.')
+    parser.add_argument('-n', '--frame', type=int, default=100,
+                        help='Value of frameCount to capture the frame at.')
+    parser.add_argument('-g', '--golden', type=str,
+                        help='Reference image to compare the capture with.')
+    parser.add_argument('output', metavar='PNG', type=str,
+                        help='Output image file.')
+    args = parser.parse_args()
+
+    loop = asyncio.get_event_loop()
+    image = loop.run_until_complete(Capture(args))
+    loop.close()
+
+    image.save(args.output)
+
+    if args.golden and os.path.isfile(args.golden):
+        golden = Image.open(args.golden).convert('RGB')
+        if golden.size != image.size:
+            raise SystemExit('Image size %dx%d differs from golden %dx%d!' %
+                             (image.size + golden.size))
+        bbox = ImageChops.difference(golden, image).getbbox()
+        if bbox:
+            raise SystemExit('Image differs from golden in area %s!' %
+                             (bbox,))
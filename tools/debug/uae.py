@@ -144,7 +144,7 @@ class UaeCommandsMixin():
         # {m <address> [<lines>]} Memory dump starting at <address>.
         if addr >= CUSTOM and addr < CUSTOM + CUSTOM_SIZE:
             return await self.read_custom(addr - CUSTOM, length)
-        lines = await self.communicate('m %x %d' % (addr, (length + 15) / 16))
+        lines = await self.communicate('m %x %d' % (addr, (length + 15) // 16))
         # 00000004 00C0 0276 00FC 0818 00FC 081A 00FC 081C  ...v............'
         # 00000014 00FC 081E 00FC 0820 00FC 0822 00FC 090E  ....... ..."....'
         # ...
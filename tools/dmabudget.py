@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+
+import argparse
+from struct import unpack
+
+# Model of OCS/ECS chipset DMA on PAL machine (see Amiga Hardware Reference
+# Manual, Figure 6-9). A raster line has 227 color clocks. Refresh, disk,
+# audio and sprite DMA use odd cycles only. Processor accesses chip memory on
+# even cycles and competes for them with copper, blitter and bitplanes 5-6
+# in low resolution (or 3-4 in high resolution).
+
+LINES = 313
+CLOCKS = 227
+
+# Position of bitplane fetch (plane number) within a fetch unit.
+LORES_FETCH = [0, 4, 6, 2, 0, 3, 5, 1]
+HIRES_FETCH = [4, 2, 3, 1]
+
+BPLCON0 = 0x100
+DDFSTRT = 0x092
+DDFSTOP = 0x094
+DIWSTRT = 0x08E
+DIWSTOP = 0x090
+DMACON = 0x096
+
+DMAF_SETCLR = 0x8000
+DMAF_RASTER = 0x0100
+DMAF_COPPER = 0x0080
+
+BPLCON0_HIRES = 0x8000
+
+
+class Display():
+    def __init__(self, hires, depth, ddfstrt, ddfstop, ystart, ystop):
+        self.hires = hires
+        self.depth = depth
+        self.ddfstrt = ddfstrt
+        self.ddfstop = ddfstop
+        self.ystart = ystart
+        self.ystop = ystop
+        self.dmacon = DMAF_RASTER | DMAF_COPPER
+
+    def write(self, reg, value):
+        if reg == BPLCON0:
+            self.hires = bool(value & BPLCON0_HIRES)
+            self.depth = (value >> 12) & 7
+        elif reg == DDFSTRT:
+            self.ddfstrt = value & 0xFC
+        elif reg == DDFSTOP:
+            self.ddfstop = value & 0xFC
+        elif reg == DIWSTRT:
+            self.ystart = value >> 8
+        elif reg == DIWSTOP:
+            # Vertical stop position has implicit 9th bit set if bit 7 is clear.
+            self.ystop = (value >> 8) | (0 if value & 0x8000 else 0x100)
+        elif reg == DMACON:
+            if value & DMAF_SETCLR:
+                self.dmacon |= value & 0x7FFF
+            else:
+                self.dmacon &= ~value
+
+    # Returns even cycles taken by bitplane fetch in given line.
+    def fetch(self, line):
+        slots = set()
+        if not (self.dmacon & DMAF_RASTER) or self.depth == 0:
+            return slots
+        if not (self.ystart <= line < self.ystop):
+            return slots
+        pattern = HIRES_FETCH if self.hires else LORES_FETCH
+        unit = len(pattern)
+        for pos in range(self.ddfstrt, self.ddfstop + 8, unit):
+            for i, plane in enumerate(pattern):
+                clock = pos + i
+                if 0 < plane <= self.depth and clock % 2 == 0:
+                    slots.add(clock)
+        return slots
+
+
+def read_copper(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    words = unpack('>%dH' % (len(data) // 2), data[:len(data) & ~1])
+    return [(words[i], words[i + 1]) for i in range(0, len(words) - 1, 2)]
+
+
+# Copper needs one free even cycle for each instruction word it fetches.
+def fetch(busy, used, h, n):
+    stall = 0
+    while n > 0 and h < CLOCKS:
+        if h % 2 == 0:
+            if h in busy or h in used:
+                stall += 2
+            else:
+                used.add(h)
+                n -= 1
+        h += 1
+    return h, n, stall
+
+
+def simulate(display, copper):
+    report = []
+    pc = 0
+    wait = None
+    pending = 0
+
+    for line in range(LINES):
+        busy = display.fetch(line)
+        used = set()
+        moves, delayed, delay = 0, 0, 0
+        h = 0
+
+        while h < CLOCKS:
+            if wait:
+                vp, hp, vm, hm = wait
+                if (line & vm) < (vp & vm):
+                    break
+                if (line & vm) == (vp & vm) and h < (hp & hm):
+                    h = hp & hm
+                    continue
+                wait = None
+
+            if pending == 0:
+                if pc >= len(copper):
+                    break
+                pending = 2
+
+            h, pending, stall = fetch(busy, used, h, pending)
+            if pending:
+                break
+
+            ir1, ir2 = copper[pc]
+            pc += 1
+
+            if ir1 & 1 == 0:
+                moves += 1
+                if stall:
+                    delayed += 1
+                    delay += stall
+                display.write(ir1 & 0x1FE, ir2)
+            elif ir1 == 0xFFFF and ir2 == 0xFFFE:
+                pc = len(copper)
+            elif ir2 & 1 == 0:
+                wait = (ir1 >> 8, ir1 & 0xFE, (ir2 >> 8) | 0x80, ir2 & 0xFE)
+            # SKIP instruction is ignored, i.e. next one is always executed.
+
+        free = len([c for c in range(0, CLOCKS, 2)
+                    if c not in busy and c not in used])
+        report.append((line, len(busy), len(used), free, moves, delayed,
+                       delay))
+
+    return report
+
+
+def print_report(report, warn):
+    print('%-9s  %4s  %6s  %4s' % ('lines', 'bpl', 'copper', 'free'))
+
+    def flush(first, last, stats):
+        lines = ('%d' % first) if first == last else ('%d-%d' % (first, last))
+        print('%-9s  %4d  %6d  %4d' % ((lines,) + stats))
+
+    first, prev = None, None
+    for line, bpl, cop, free, *_ in report:
+        stats = (bpl, cop, free)
+        if stats != prev:
+            if prev is not None:
+                flush(first, line - 1, prev)
+            first, prev = line, stats
+    flush(first, LINES - 1, prev)
+
+    total = sum(r[3] for r in report)
+    worst = min(report, key=lambda r: r[3])
+    print()
+    print('Even cycles free for CPU and blitter: %d per frame, '
+          'worst line %d has %d.' % (total, worst[0], worst[3]))
+
+    for line, _, _, _, moves, delayed, delay in report:
+        if delayed and warn:
+            print('Warning: line %d: %d of %d copper moves delayed by %d '
+                  'clocks by bitplane fetch!' % (line, delayed, moves, delay))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Estimate DMA slot budget of a screen setup.')
+    parser.add_argument('--hires', action='store_true',
+                        help='High resolution mode (MODE_HIRES).')
+    parser.add_argument('--depth', type=int, default=0,
+                        help='Number of bitplanes.')
+    parser.add_argument('--xs', type=int, default=0x81,
+                        help='Horizontal start of display window.')
+    parser.add_argument('--ys', type=int, default=0x2c,
+                        help='Vertical start of display window.')
+    parser.add_argument('--width', type=int, default=320,
+                        help='Width of display window in pixels.')
+    parser.add_argument('--height', type=int, default=256,
+                        help='Height of display window in lines.')
+    parser.add_argument('--ddfstrt', type=lambda x: int(x, 0),
+                        help='Override DDFSTRT computed from window.')
+    parser.add_argument('--ddfstop', type=lambda x: int(x, 0),
+                        help='Override DDFSTOP computed from window.')
+    parser.add_argument('--copper', type=str,
+                        help='Memory dump of copper list (big endian).')
+    parser.add_argument('--quiet', action='store_true',
+                        help='Do not warn about copper moves being delayed.')
+    args = parser.parse_args()
+
+    # Same calculation as in SetupBitplaneFetch.
+    if args.hires:
+        ddfstrt = ((args.xs - 9) >> 1) & ~3
+        ddfstop = ddfstrt + (args.width >> 2) - 8
+    else:
+        ddfstrt = ((args.xs - 17) >> 1) & ~7
+        ddfstop = ddfstrt + (args.width >> 1) - 8
+
+    if args.ddfstrt is not None:
+        ddfstrt = args.ddfstrt
+    if args.ddfstop is not None:
+        ddfstop = args.ddfstop
+
+    display = Display(args.hires, args.depth, ddfstrt, ddfstop,
+                      args.ys, args.ys + args.height)
+    copper = read_copper(args.copper) if args.copper else []
+
+    print_report(simulate(display, copper), not args.quiet)
@@ -3,6 +3,7 @@
 import argparse
 import os
 import stat
+import zlib
 from array import array
 from collections import UserList
 from fnmatch import fnmatch
@@ -16,13 +17,16 @@ from io import BytesIO
 #  [WORD] dirsize : total size of directory entries in bytes
 #  for each directory entry (2-byte aligned):
 #   [BYTE] #reclen : total size of this record
-#   [BYTE] #type   : type of file (1: executable, 0: regular)
+#   [BYTE] #type   : type of file (bit 0: executable, bit 1: packed)
 #   [WORD] #start  : sector where the file begins (0..1759)
 #   [LONG] #length : size of the file in bytes (up to 1MiB)
 #   [STRING] #name : name of the file (NUL terminated)
 #
 # sector (n)..(n+k-1): content of files
 #
+# Content of packed file is a LONG with size of raw DEFLATE stream that
+# follows it. Length in directory entry is the size of file after inflation.
+#
 
 SECTOR = 512
 
@@ -43,8 +47,12 @@ def write_pad(fh, alignment=None):
     fh.write(b'\0' * pad)
 
 
+TYPE_EXE = 1
+TYPE_PACKED = 2
+
+
 class FileEntry(object):
-    __slots__ = ('name', 'offset', 'exe', 'size', 'data')
+    __slots__ = ('name', 'offset', 'exe', 'size', 'data', 'packed')
 
     def __init__(self, name, offset, exe, size=0, data=None):
         self.name = name
@@ -52,17 +60,37 @@ class FileEntry(object):
         self.exe = exe
         self.size = size
         self.data = data
+        self.packed = None
 
     def __str__(self):
         s = '%-32s %6d' % (self.name, self.size)
         if self.exe:
             s += ' (executable)'
+        if self.packed:
+            s += ' (packed to %d)' % len(self.packed)
         return s
 
     def __len__(self):
         assert self.size == len(self.data)
         return self.size
 
+    @property
+    def type(self):
+        return int(self.exe) | (TYPE_PACKED if self.packed else 0)
+
+    @property
+    def content(self):
+        if self.packed:
+            return self.packed
+        return self.data
+
+    def pack(self):
+        comp = zlib.compressobj(9, zlib.DEFLATED, -15)
+        stream = comp.compress(self.data) + comp.flush()
+        # Keep the file as is unless compression saves some sectors.
+        if align(4 + len(stream)) < align(self.size):
+            self.packed = pack('>I', len(stream)) + stream
+
 
 class Filesystem(UserList):
     @classmethod
@@ -70,15 +98,24 @@ class Filesystem(UserList):
         dir_len = unpack('>H', fh.read(2))[0]
 
         entries = []
+        packed = []
         while dir_len > 0:
-            reclen, exe, offset, size = unpack('>BBHI', fh.read(8))
+            reclen, typ, offset, size = unpack('>BBHI', fh.read(8))
             name = fh.read(reclen - 8).decode().rstrip('\0')
             dir_len -= reclen
-            entries.append(FileEntry(name, offset * SECTOR, exe, size))
+            entries.append(FileEntry(name, offset * SECTOR,
+                                     bool(typ & TYPE_EXE), size))
+            packed.append(bool(typ & TYPE_PACKED))
 
-        for i, entry in enumerate(entries):
+        for entry, is_packed in zip(entries, packed):
             fh.seek(entry.offset)
-            entry.data = fh.read(entry.size)
+            if is_packed:
+                length = unpack('>I', fh.read(4))[0]
+                stream = fh.read(length)
+                entry.packed = pack('>I', length) + stream
+                entry.data = zlib.decompress(stream, -15)
+            else:
+                entry.data = fh.read(entry.size)
 
         return cls(entries)
 
@@ -111,31 +148,41 @@ class Filesystem(UserList):
 
         return cls(entries)
 
-    def save(self, path):
+    def relocate(self):
+        # Assign positions of files relative to the end of directory
+        file_off = 0
+        for entry in self.data:
+            entry.offset = file_off
+            file_off += align(len(entry.content))
+
+    def write(self, fh):
         # Determine directory size
         dir_len = sum(align(8 + len(entry.name) + 1, 2) for entry in self.data)
 
         # Calculate starting position of files in the file system image
         files_pos = align(dir_len)
 
-        with open(path, 'wb') as fh:
-            # Write directory header
-            fh.write(pack('>H', dir_len))
-            # Write directory entries
-            for entry in self.data:
-                start = sectors(entry.offset + files_pos)
-                reclen = align(8 + len(entry.name) + 1, 2)
-                name = entry.name.encode('ascii') + b'\0'
-                fh.write(pack('>BBHI%ds' % len(name),
-                              reclen, int(entry.exe), start, len(entry), name))
-                write_pad(fh, 2)
-            # Finish off directory by aligning it to sector boundary
+        # Write directory header
+        fh.write(pack('>H', dir_len))
+        # Write directory entries
+        for entry in self.data:
+            start = sectors(entry.offset + files_pos)
+            reclen = align(8 + len(entry.name) + 1, 2)
+            name = entry.name.encode('ascii') + b'\0'
+            fh.write(pack('>BBHI%ds' % len(name),
+                          reclen, entry.type, start, len(entry), name))
+            write_pad(fh, 2)
+        # Finish off directory by aligning it to sector boundary
+        write_pad(fh)
+
+        # Write file entries
+        for entry in self.data:
+            fh.write(entry.content)
             write_pad(fh)
 
-            # Write file entries
-            for entry in self.data:
-                fh.write(entry.data)
-                write_pad(fh)
+    def save(self, path):
+        with open(path, 'wb') as fh:
+            self.write(fh)
 
     @classmethod
     def find_exec(cls, path):
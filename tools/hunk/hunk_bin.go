@@ -8,15 +8,21 @@ import (
 
 type HunkBin struct {
 	htype HunkType
+	Flags uint32
 	Bytes []byte
 }
 
+func readHunkBin(r io.Reader, htype HunkType) HunkBin {
+	n := readLong(r)
+	return HunkBin{htype, n & HUNKF_MASK, readData(r, (n&^HUNKF_MASK)*4)}
+}
+
 func readHunkCode(r io.Reader) HunkBin {
-	return HunkBin{HUNK_CODE, readData(r, readLong(r)*4)}
+	return readHunkBin(r, HUNK_CODE)
 }
 
 func readHunkData(r io.Reader) HunkBin {
-	return HunkBin{HUNK_DATA, readData(r, readLong(r)*4)}
+	return readHunkBin(r, HUNK_DATA)
 }
 
 func (h HunkBin) Type() HunkType {
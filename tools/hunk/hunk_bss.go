@@ -6,11 +6,13 @@ import (
 )
 
 type HunkBss struct {
-	Size uint32
+	Flags uint32
+	Size  uint32
 }
 
 func readHunkBss(r io.Reader) HunkBss {
-	return HunkBss{readLong(r) * 4}
+	n := readLong(r)
+	return HunkBss{n & HUNKF_MASK, (n &^ HUNKF_MASK) * 4}
 }
 
 func (h HunkBss) Type() HunkType {
@@ -3,6 +3,7 @@ package hunk
 import (
 	"fmt"
 	"io"
+	"os"
 	"sort"
 	"strings"
 )
@@ -45,7 +46,7 @@ func readStrTab(r io.Reader, size uint32) []byte {
 }
 
 func readHunkDebugGnu(r io.Reader, name string) HunkDebugGnu {
-	fmt.Printf("HunkDebugGnu: %s\n", name)
+	fmt.Fprintf(os.Stderr, "HunkDebugGnu: %s\n", name)
 	var stabTab []Stab
 	var stabstrTab []byte
 	if name == "" {
@@ -70,6 +71,10 @@ func readHunkDebugGnu(r io.Reader, name string) HunkDebugGnu {
 	return HunkDebugGnu{stabTab, stabstrTab}
 }
 
+func (h HunkDebugGnu) StringTable() map[int]string {
+	return parseStringTable(h.StabStrTab)
+}
+
 func (h HunkDebugGnu) Type() HunkType {
 	return HUNK_DEBUG
 }
@@ -0,0 +1,309 @@
+package main
+
+import (
+	"flag"
+	"fmt"
+	"ghostown.pl/hunk"
+	"os"
+	"sort"
+	"strings"
+)
+
+type Sizes struct {
+	Code uint32
+	Data uint32
+	Bss  uint32
+	Chip uint32
+}
+
+func (s *Sizes) Total() uint32 {
+	return s.Code + s.Data + s.Bss
+}
+
+func (s *Sizes) Add(kind hunk.HunkType, chip bool, size uint32) {
+	switch kind {
+	case hunk.HUNK_CODE:
+		s.Code += size
+	case hunk.HUNK_DATA:
+		s.Data += size
+	case hunk.HUNK_BSS:
+		s.Bss += size
+	}
+	if chip {
+		s.Chip += size
+	}
+}
+
+type Report map[string]*Sizes
+
+func (r Report) Add(name string, kind hunk.HunkType, chip bool, size uint32) {
+	if r[name] == nil {
+		r[name] = &Sizes{}
+	}
+	r[name].Add(kind, chip, size)
+}
+
+func (r Report) Total() (total Sizes) {
+	for _, s := range r {
+		total.Code += s.Code
+		total.Data += s.Data
+		total.Bss += s.Bss
+		total.Chip += s.Chip
+	}
+	return
+}
+
+type Segment struct {
+	Type    hunk.HunkType
+	Chip    bool
+	Size    uint32
+	Symbols []hunk.SymbolDef
+}
+
+var printHelp bool
+var groupBy string
+
+func init() {
+	flag.BoolVar(&printHelp, "help", false,
+		"print help message and exit")
+	flag.StringVar(&groupBy, "by", "section",
+		"attribute sizes to: section, symbol, object or library")
+}
+
+func readSegments(path string) (segments []*Segment) {
+	hunks, err := hunk.ReadFile(path)
+	if err != nil {
+		panic("failed to read Amiga Hunk file")
+	}
+
+	var header hunk.HunkHeader
+	var last *Segment
+
+	for _, h := range hunks {
+		switch h.Type() {
+		case hunk.HUNK_HEADER:
+			header = h.(hunk.HunkHeader)
+		case hunk.HUNK_CODE, hunk.HUNK_DATA:
+			hb := h.(hunk.HunkBin)
+			last = &Segment{Type: h.Type(), Chip: hb.Flags&hunk.HUNKF_CHIP != 0,
+				Size: uint32(len(hb.Bytes))}
+			segments = append(segments, last)
+		case hunk.HUNK_BSS:
+			hb := h.(hunk.HunkBss)
+			last = &Segment{Type: h.Type(), Chip: hb.Flags&hunk.HUNKF_CHIP != 0,
+				Size: hb.Size}
+			segments = append(segments, last)
+		case hunk.HUNK_SYMBOL:
+			if last != nil {
+				last.Symbols = h.(hunk.HunkSymbol).Symbol
+			}
+		}
+	}
+
+	/* Memory type is usually given only in the header. */
+	for i, s := range segments {
+		if i < len(header.Specifiers) &&
+			header.Specifiers[i]&hunk.HUNKF_CHIP != 0 {
+			s.Chip = true
+		}
+	}
+
+	return segments
+}
+
+func sectionName(kind hunk.HunkType, chip bool) string {
+	name := strings.TrimPrefix(hunk.HunkNameMap[kind], "HUNK_")
+	if chip {
+		name += " (chip)"
+	}
+	return name
+}
+
+func bySection(segments []*Segment) Report {
+	report := make(Report)
+	for _, s := range segments {
+		report.Add(sectionName(s.Type, s.Chip), s.Type, s.Chip, s.Size)
+	}
+	return report
+}
+
+/* Symbol size is the distance to the next symbol within the same hunk.
+ * Local labels (starting with a dot) are accounted to preceding symbol. */
+func bySymbol(segments []*Segment) Report {
+	report := make(Report)
+
+	for i, s := range segments {
+		name := fmt.Sprintf("<hunk %d>", i)
+		start := uint32(0)
+
+		for _, sym := range s.Symbols {
+			if strings.HasPrefix(sym.Name, ".") || sym.Value > s.Size {
+				continue
+			}
+			report.Add(name, s.Type, s.Chip, sym.Value-start)
+			name = strings.TrimPrefix(sym.Name, "_")
+			start = sym.Value
+		}
+
+		report.Add(name, s.Type, s.Chip, s.Size-start)
+	}
+
+	for name, sizes := range report {
+		if sizes.Total() == 0 {
+			delete(report, name)
+		}
+	}
+
+	return report
+}
+
+func byInputSection(path string, library bool) Report {
+	mapPath := strings.TrimSuffix(path, ".dbg") + ".map"
+	sections, err := readMapFile(mapPath)
+	if err != nil {
+		fmt.Fprintf(os.Stderr, "failed to read map file: %v\n", err)
+		os.Exit(1)
+	}
+
+	report := make(Report)
+	for _, s := range sections {
+		var kind hunk.HunkType
+		switch {
+		case strings.HasPrefix(s.Section, ".text"):
+			kind = hunk.HUNK_CODE
+		case strings.HasPrefix(s.Section, ".data"):
+			kind = hunk.HUNK_DATA
+		case strings.HasPrefix(s.Section, ".bss"):
+			kind = hunk.HUNK_BSS
+		default:
+			continue
+		}
+		chip := strings.HasSuffix(s.Section, "chip")
+
+		name := s.Object
+		if library {
+			name = s.Library
+			if name == "" {
+				name = "<objects>"
+			}
+		} else if s.Library != "" {
+			name = s.Library + "(" + s.Object + ")"
+		}
+		report.Add(name, kind, chip, s.Size)
+	}
+	return report
+}
+
+func makeReport(path string) Report {
+	switch groupBy {
+	case "section":
+		return bySection(readSegments(path))
+	case "symbol":
+		return bySymbol(readSegments(path))
+	case "object":
+		return byInputSection(path, false)
+	case "library":
+		return byInputSection(path, true)
+	}
+	fmt.Fprintf(os.Stderr, "unknown grouping: %s\n", groupBy)
+	os.Exit(1)
+	return nil
+}
+
+func sortedNames(r Report, less func(a, b string) bool) (names []string) {
+	for name := range r {
+		names = append(names, name)
+	}
+	sort.Slice(names, func(i, j int) bool {
+		return less(names[i], names[j])
+	})
+	return names
+}
+
+func printReport(r Report) {
+	names := sortedNames(r, func(a, b string) bool {
+		if r[a].Total() != r[b].Total() {
+			return r[a].Total() > r[b].Total()
+		}
+		return a < b
+	})
+
+	fmt.Println("    code     data      bss     chip    total  name")
+	for _, name := range names {
+		s := r[name]
+		fmt.Printf("%8d %8d %8d %8d %8d  %s\n",
+			s.Code, s.Data, s.Bss, s.Chip, s.Total(), name)
+	}
+	t := r.Total()
+	fmt.Printf("%8d %8d %8d %8d %8d  total\n",
+		t.Code, t.Data, t.Bss, t.Chip, t.Total())
+}
+
+func printDiff(old, new Report) {
+	delta := func(name string) int {
+		var o, n Sizes
+		if s := old[name]; s != nil {
+			o = *s
+		}
+		if s := new[name]; s != nil {
+			n = *s
+		}
+		return int(n.Total()) - int(o.Total())
+	}
+
+	union := make(Report)
+	for name := range old {
+		union[name] = old[name]
+	}
+	for name := range new {
+		union[name] = new[name]
+	}
+
+	names := sortedNames(union, func(a, b string) bool {
+		if delta(a) != delta(b) {
+			return delta(a) > delta(b)
+		}
+		return a < b
+	})
+
+	fmt.Println("     old      new    delta     chip  name")
+	for _, name := range names {
+		var o, n Sizes
+		if s := old[name]; s != nil {
+			o = *s
+		}
+		if s := new[name]; s != nil {
+			n = *s
+		}
+		if o == n {
+			continue
+		}
+		fmt.Printf("%8d %8d %+8d %+8d  %s\n", o.Total(), n.Total(),
+			int(n.Total())-int(o.Total()), int(n.Chip)-int(o.Chip), name)
+	}
+	o, n := old.Total(), new.Total()
+	fmt.Printf("%8d %8d %+8d %+8d  total\n", o.Total(), n.Total(),
+		int(n.Total())-int(o.Total()), int(n.Chip)-int(o.Chip))
+}
+
+func main() {
+	flag.Parse()
+
+	if len(flag.Args()) < 1 || len(flag.Args()) > 2 || printHelp {
+		fmt.Println("Usage: hunksize [-by grouping] program.exe.dbg " +
+			"[new-program.exe.dbg]")
+		fmt.Println()
+		fmt.Println("Prints size breakdown of an executable, or differences " +
+			"between two builds.")
+		fmt.Println("Object and library grouping reads linker map file " +
+			"(program.exe.map).")
+		flag.PrintDefaults()
+		os.Exit(1)
+	}
+
+	if len(flag.Args()) == 1 {
+		printReport(makeReport(flag.Arg(0)))
+	} else {
+		printDiff(makeReport(flag.Arg(0)), makeReport(flag.Arg(1)))
+	}
+}
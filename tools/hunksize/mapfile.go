@@ -0,0 +1,84 @@
+package main
+
+import (
+	"bufio"
+	"os"
+	"path/filepath"
+	"regexp"
+	"strconv"
+	"strings"
+)
+
+/* Input section placed by the linker into one of output sections. */
+type InputSection struct {
+	Section string
+	Address uint32
+	Size    uint32
+	Library string
+	Object  string
+}
+
+var reOutput = regexp.MustCompile(`^(\.\w+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)`)
+var reInput = regexp.MustCompile(
+	`^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+)$`)
+var reMember = regexp.MustCompile(`^(.*)\((.*)\)$`)
+
+/* Reads memory map written by GNU ld with -Map option. Input section lines
+ * look like " .text  0x00000100  0x200 /path/libfoo.a(bar.o)", but if name
+ * of input section is too long, the rest is moved to the following line. */
+func readMapFile(path string) (sections []InputSection, err error) {
+	file, err := os.Open(path)
+	if err != nil {
+		return nil, err
+	}
+	defer file.Close()
+
+	var output, input string
+
+	scanner := bufio.NewScanner(file)
+	for scanner.Scan() {
+		line := scanner.Text()
+
+		if m := reOutput.FindStringSubmatch(line); m != nil {
+			output = m[1]
+			input = ""
+			continue
+		}
+
+		if output == "" || !strings.HasPrefix(line, " ") {
+			continue
+		}
+
+		fs := strings.Fields(line)
+		if len(fs) > 0 && !strings.HasPrefix(fs[0], "0x") {
+			input = fs[0]
+			line = strings.TrimPrefix(strings.TrimSpace(line), input)
+			if strings.TrimSpace(line) == "" {
+				continue
+			}
+		}
+
+		m := reInput.FindStringSubmatch(line)
+		if m == nil || input == "" {
+			continue
+		}
+
+		address, _ := strconv.ParseUint(m[1], 16, 32)
+		size, _ := strconv.ParseUint(m[2], 16, 32)
+		input = ""
+
+		if size == 0 {
+			continue
+		}
+
+		s := InputSection{Section: output, Address: uint32(address),
+			Size: uint32(size), Object: filepath.Base(m[3])}
+		if mm := reMember.FindStringSubmatch(m[3]); mm != nil {
+			s.Library = filepath.Base(mm[1])
+			s.Object = mm[2]
+		}
+		sections = append(sections, s)
+	}
+
+	return sections, scanner.Err()
+}
@@ -0,0 +1,286 @@
+package main
+
+import (
+	"bufio"
+	"encoding/binary"
+	"flag"
+	"fmt"
+	"ghostown.pl/hunk"
+	"io"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+)
+
+/* Must match definitions in system/debug.c */
+const (
+	LOG_SEGMENTS = 0
+	LOG_DROPPED  = 1
+	LOG_HUNKS    = 2
+)
+
+type Segment struct {
+	Bytes []byte
+	Size  uint32
+	Base  uint32
+}
+
+type PartList []string
+
+func (l *PartList) String() string {
+	return strings.Join(*l, ",")
+}
+
+func (l *PartList) Set(path string) error {
+	*l = append(*l, path)
+	return nil
+}
+
+var printHelp bool
+var textInput bool
+var parts PartList
+
+func init() {
+	flag.BoolVar(&printHelp, "help", false,
+		"print help message and exit")
+	flag.BoolVar(&textInput, "text", false,
+		"input is emulator log with records encoded as '@xxxxxxxx' lines")
+	flag.Var(&parts, "part",
+		"debug file of trackmo part (e.g. plasma.part.dbg), can be repeated")
+}
+
+func readSegments(path string) (segments []*Segment) {
+	hunks, err := hunk.ReadFile(path)
+	if err != nil {
+		panic("failed to read Amiga Hunk file")
+	}
+
+	for _, h := range hunks {
+		switch h.Type() {
+		case hunk.HUNK_CODE, hunk.HUNK_DATA:
+			bin := h.(hunk.HunkBin)
+			segments = append(segments,
+				&Segment{bin.Bytes, uint32(len(bin.Bytes)), 0})
+		case hunk.HUNK_BSS:
+			bss := h.(hunk.HunkBss)
+			segments = append(segments, &Segment{nil, bss.Size, 0})
+		}
+	}
+	return
+}
+
+/* Address stored in the log is 24-bit wide, as is 68000 address bus. */
+func lookup(segments []*Segment, addr uint32) (*Segment, uint32) {
+	for _, s := range segments {
+		if s.Base == 0 || s.Bytes == nil {
+			continue
+		}
+		base := s.Base & 0xffffff
+		if addr >= base && addr < base+s.Size {
+			return s, addr - base
+		}
+	}
+	return nil, 0
+}
+
+func readString(segments []*Segment, addr uint32) (string, bool) {
+	s, off := lookup(segments, addr&0xffffff)
+	if s == nil {
+		return "", false
+	}
+	end := off
+	for end < s.Size && s.Bytes[end] != 0 {
+		end++
+	}
+	return string(s.Bytes[off:end]), true
+}
+
+/* Reimplements the subset of kvprintf conversions used by our code. */
+func format(segments []*Segment, fmtstr string, args []uint32) string {
+	var sb strings.Builder
+
+	for i := 0; i < len(fmtstr); i++ {
+		c := fmtstr[i]
+		if c != '%' {
+			sb.WriteByte(c)
+			continue
+		}
+
+		j := i + 1
+		for j < len(fmtstr) && strings.IndexByte("-+# 0", fmtstr[j]) >= 0 {
+			j++
+		}
+		for j < len(fmtstr) && strings.IndexByte("0123456789.", fmtstr[j]) >= 0 {
+			j++
+		}
+		spec := fmtstr[i:j]
+		for j < len(fmtstr) && strings.IndexByte("hlqjtz", fmtstr[j]) >= 0 {
+			j++
+		}
+		if j >= len(fmtstr) {
+			sb.WriteString(fmtstr[i:])
+			break
+		}
+		conv := fmtstr[j]
+		i = j
+
+		if conv == '%' {
+			sb.WriteByte('%')
+			continue
+		}
+
+		if len(args) == 0 {
+			sb.WriteString("<missing>")
+			continue
+		}
+		arg := args[0]
+		args = args[1:]
+
+		switch conv {
+		case 'd', 'i':
+			sb.WriteString(fmt.Sprintf(spec+"d", int32(arg)))
+		case 'u':
+			sb.WriteString(fmt.Sprintf(spec+"d", arg))
+		case 'x', 'X', 'o':
+			sb.WriteString(fmt.Sprintf(spec+string(conv), arg))
+		case 'p':
+			sb.WriteString(fmt.Sprintf("0x%x", arg))
+		case 'c':
+			sb.WriteString(fmt.Sprintf(spec+"c", rune(byte(arg))))
+		case 's':
+			if str, ok := readString(segments, arg); ok {
+				sb.WriteString(fmt.Sprintf(spec+"s", str))
+			} else {
+				sb.WriteString(fmt.Sprintf("<$%08x>", arg))
+			}
+		default:
+			sb.WriteString(fmt.Sprintf("<%%%c:$%08x>", conv, arg))
+		}
+	}
+
+	return sb.String()
+}
+
+type LongReader func() (uint32, bool)
+
+func binaryReader(r io.Reader) LongReader {
+	br := bufio.NewReader(r)
+	return func() (x uint32, ok bool) {
+		ok = binary.Read(br, binary.BigEndian, &x) == nil
+		return
+	}
+}
+
+/* Emulator log contains other messages as well, so pass them through. */
+func textReader(r io.Reader) LongReader {
+	scanner := bufio.NewScanner(r)
+	return func() (uint32, bool) {
+		for scanner.Scan() {
+			line := strings.TrimSpace(scanner.Text())
+			if !strings.HasPrefix(line, "@") {
+				fmt.Println(line)
+				continue
+			}
+			x, err := strconv.ParseUint(line[1:], 16, 32)
+			if err != nil {
+				continue
+			}
+			return uint32(x), true
+		}
+		return 0, false
+	}
+}
+
+/* Part may be loaded where previous one lived, so its segments go first. */
+func loadPart(segments []*Segment, name string, bases []uint32) []*Segment {
+	for _, path := range parts {
+		if filepath.Base(path) != name+".dbg" {
+			continue
+		}
+		loaded := readSegments(path)
+		for i, base := range bases {
+			if i < len(loaded) {
+				loaded[i].Base = base
+			}
+		}
+		return append(loaded, segments...)
+	}
+	fmt.Printf("[LogDecode] No debug file for '%s'!\n", name)
+	return segments
+}
+
+func decode(segments []*Segment, next LongReader) {
+	for {
+		header, ok := next()
+		if !ok {
+			return
+		}
+
+		nargs := int(header >> 24)
+		args := make([]uint32, nargs)
+		for i := range args {
+			if args[i], ok = next(); !ok {
+				fmt.Fprintln(os.Stderr, "Truncated record!")
+				return
+			}
+		}
+
+		addr := header & 0xffffff
+		if addr == 0 {
+			if nargs == 0 {
+				continue
+			}
+			switch args[0] {
+			case LOG_SEGMENTS:
+				for i, base := range args[1:] {
+					if i < len(segments) {
+						segments[i].Base = base
+					}
+				}
+			case LOG_DROPPED:
+				fmt.Printf("[LogDecode] %d messages dropped!\n", args[1])
+			case LOG_HUNKS:
+				if name, ok := readString(segments, args[1]); ok {
+					segments = loadPart(segments, name, args[2:])
+				}
+			}
+			continue
+		}
+
+		if fmtstr, ok := readString(segments, addr); ok {
+			fmt.Print(format(segments, fmtstr, args))
+		} else {
+			fmt.Printf("[LogDecode] Unknown format string at $%06x!\n", addr)
+		}
+	}
+}
+
+func main() {
+	flag.Parse()
+
+	if len(flag.Args()) < 1 || printHelp {
+		fmt.Println("Usage: logdecode [-text] [-part file.part.dbg] " +
+			"program.exe.dbg [log]")
+		flag.PrintDefaults()
+		os.Exit(1)
+	}
+
+	segments := readSegments(flag.Arg(0))
+
+	input := os.Stdin
+	if len(flag.Args()) > 1 {
+		file, err := os.Open(flag.Arg(1))
+		if err != nil {
+			panic(err)
+		}
+		defer file.Close()
+		input = file
+	}
+
+	if textInput {
+		decode(segments, textReader(input))
+	} else {
+		decode(segments, binaryReader(input))
+	}
+}
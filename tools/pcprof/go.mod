@@ -0,0 +1,7 @@
+module ghostown.pl/pcprof
+
+go 1.17
+
+replace ghostown.pl/hunk => ../hunk
+
+require ghostown.pl/hunk v0.0.0-00010101000000-000000000000
@@ -0,0 +1,281 @@
+package main
+
+import (
+	"bufio"
+	"flag"
+	"fmt"
+	"ghostown.pl/hunk"
+	"os"
+	"regexp"
+	"sort"
+	"strconv"
+	"strings"
+)
+
+type Line struct {
+	Offset uint32
+	File   string
+	Line   int
+}
+
+type Segment struct {
+	Type    hunk.HunkType
+	Size    uint32
+	Base    uint32
+	Symbols []hunk.SymbolDef
+	Lines   []Line
+}
+
+type Entry struct {
+	Name    string
+	Samples int
+}
+
+var printHelp bool
+var showLines bool
+var showTasks bool
+
+func init() {
+	flag.BoolVar(&printHelp, "help", false,
+		"print help message and exit")
+	flag.BoolVar(&showLines, "lines", false,
+		"print profile of source lines instead of functions")
+	flag.BoolVar(&showTasks, "tasks", false,
+		"print separate profile for each task")
+}
+
+/* Line numbers are usually given relative to function start, but older
+ * toolchains emit absolute addresses. */
+func readLines(stabs []hunk.Stab, strtab map[int]string) []Line {
+	var lines []Line
+	var dir, file string
+	var fun uint32
+	relative := false
+
+	for _, s := range stabs {
+		switch s.Type() {
+		case hunk.FUN:
+			fun = s.Value
+		case hunk.SLINE:
+			if s.Value < fun {
+				relative = true
+			}
+		}
+	}
+
+	fun = 0
+	for _, s := range stabs {
+		str := strtab[int(s.StrOff)]
+		switch s.Type() {
+		case hunk.SO:
+			if strings.HasSuffix(str, "/") {
+				dir = str
+			} else if str != "" {
+				file = str
+				if !strings.HasPrefix(file, "/") {
+					file = dir + file
+				}
+			}
+		case hunk.SOL:
+			file = str
+		case hunk.FUN:
+			fun = s.Value
+		case hunk.SLINE:
+			offset := s.Value
+			if relative {
+				offset += fun
+			}
+			lines = append(lines, Line{offset, file, int(s.Desc)})
+		}
+	}
+
+	sort.SliceStable(lines, func(i, j int) bool {
+		return lines[i].Offset < lines[j].Offset
+	})
+	return lines
+}
+
+func readSegments(path string) (segments []*Segment) {
+	hunks, err := hunk.ReadFile(path)
+	if err != nil {
+		panic("failed to read Amiga Hunk file")
+	}
+
+	var last *Segment
+	var stabs []hunk.Stab
+	strtab := make(map[int]string)
+
+	for _, h := range hunks {
+		switch h.Type() {
+		case hunk.HUNK_CODE, hunk.HUNK_DATA:
+			last = &Segment{Type: h.Type(),
+				Size: uint32(len(h.(hunk.HunkBin).Bytes))}
+			segments = append(segments, last)
+		case hunk.HUNK_BSS:
+			last = &Segment{Type: h.Type(), Size: h.(hunk.HunkBss).Size}
+			segments = append(segments, last)
+		case hunk.HUNK_SYMBOL:
+			if last != nil {
+				last.Symbols = h.(hunk.HunkSymbol).Symbol
+			}
+		case hunk.HUNK_DEBUG:
+			debug := h.(hunk.HunkDebugGnu)
+			stabs = append(stabs, debug.StabTab...)
+			for k, v := range debug.StringTable() {
+				strtab[k] = v
+			}
+		case hunk.HUNK_END:
+			if last != nil && stabs != nil {
+				last.Lines = readLines(stabs, strtab)
+			}
+			stabs = nil
+			strtab = make(map[int]string)
+		}
+	}
+
+	return segments
+}
+
+func lookupSymbol(s *Segment, offset uint32) string {
+	i := sort.Search(len(s.Symbols), func(i int) bool {
+		return s.Symbols[i].Value > offset
+	})
+	for i--; i >= 0; i-- {
+		name := s.Symbols[i].Name
+		if !strings.HasPrefix(name, ".") {
+			return strings.TrimPrefix(name, "_")
+		}
+	}
+	return ""
+}
+
+func lookupLine(s *Segment, offset uint32) string {
+	i := sort.Search(len(s.Lines), func(i int) bool {
+		return s.Lines[i].Offset > offset
+	})
+	if i == 0 {
+		return ""
+	}
+	l := s.Lines[i-1]
+	return fmt.Sprintf("%s:%d", l.File, l.Line)
+}
+
+func symbolise(segments []*Segment, pc uint32) string {
+	for _, s := range segments {
+		if s.Base == 0 || pc < s.Base || pc >= s.Base+s.Size {
+			continue
+		}
+		offset := pc - s.Base
+		var name string
+		if showLines {
+			name = lookupLine(s, offset)
+		} else {
+			name = lookupSymbol(s, offset)
+		}
+		if name == "" {
+			name = fmt.Sprintf("<segment %x+$%x>", s.Base, offset)
+		}
+		return name
+	}
+	return fmt.Sprintf("<unknown $%08x>", pc)
+}
+
+func report(title string, histogram map[string]int) {
+	var entries []Entry
+	total := 0
+
+	for name, n := range histogram {
+		entries = append(entries, Entry{name, n})
+		total += n
+	}
+
+	sort.Slice(entries, func(i, j int) bool {
+		if entries[i].Samples != entries[j].Samples {
+			return entries[i].Samples > entries[j].Samples
+		}
+		return entries[i].Name < entries[j].Name
+	})
+
+	fmt.Printf("%s (%d samples)\n", title, total)
+	fmt.Println("     %   cumul%   samples  name")
+	cumul := 0
+	for _, e := range entries {
+		cumul += e.Samples
+		fmt.Printf("%6.2f  %6.2f  %8d  %s\n",
+			100.0*float64(e.Samples)/float64(total),
+			100.0*float64(cumul)/float64(total), e.Samples, e.Name)
+	}
+	fmt.Println()
+}
+
+var reHeader = regexp.MustCompile(`\[Sampler\] \d+ samples at`)
+var reSegment = regexp.MustCompile(`\[Sampler\] segment \$([0-9a-fA-F]+)`)
+var reTask = regexp.MustCompile(`\[Sampler\] task \$([0-9a-fA-F]+) (.*)`)
+var reSample = regexp.MustCompile(
+	`\[Sampler\] \$([0-9a-fA-F]+) \$([0-9a-fA-F]+) (\d+)`)
+
+func parseHex(s string) uint32 {
+	x, _ := strconv.ParseUint(s, 16, 32)
+	return uint32(x)
+}
+
+func main() {
+	flag.Parse()
+
+	if len(flag.Args()) < 1 || printHelp {
+		fmt.Println("Usage: pcprof [-lines] [-tasks] program.exe.dbg [log]")
+		flag.PrintDefaults()
+		os.Exit(1)
+	}
+
+	segments := readSegments(flag.Arg(0))
+
+	input := os.Stdin
+	if len(flag.Args()) > 1 {
+		file, err := os.Open(flag.Arg(1))
+		if err != nil {
+			panic(err)
+		}
+		defer file.Close()
+		input = file
+	}
+
+	taskNames := make(map[uint32]string)
+	histograms := make(map[string]map[string]int)
+	var order []string
+	nseg := 0
+
+	scanner := bufio.NewScanner(input)
+	for scanner.Scan() {
+		line := scanner.Text()
+		if reHeader.MatchString(line) {
+			nseg = 0
+		} else if m := reSegment.FindStringSubmatch(line); m != nil {
+			if nseg < len(segments) {
+				segments[nseg].Base = parseHex(m[1])
+			}
+			nseg++
+		} else if m := reTask.FindStringSubmatch(line); m != nil {
+			taskNames[parseHex(m[1])] = strings.TrimSpace(m[2])
+		} else if m := reSample.FindStringSubmatch(line); m != nil {
+			task := "all tasks"
+			if showTasks {
+				task = "task " + taskNames[parseHex(m[1])]
+			}
+			if histograms[task] == nil {
+				histograms[task] = make(map[string]int)
+				order = append(order, task)
+			}
+			n, _ := strconv.Atoi(m[3])
+			histograms[task][symbolise(segments, parseHex(m[2]))] += n
+		}
+	}
+
+	if nseg == 0 {
+		fmt.Fprintln(os.Stderr, "No segment information found in the log!")
+	}
+
+	for _, task := range order {
+		report("Flat profile for "+task, histograms[task])
+	}
+}
@@ -94,13 +94,14 @@ def do_bitmap(im, desc):
         raise SystemExit('Only 8-bit images supported.')
 
     param = parse(desc, ('name', str), (('width', 'height', 'depth'), dim),
-                  interleaved=False)
+                  interleaved=False, mask=False)
 
     name = param['name']
     has_width = param['width']
     has_height = param['height']
     has_depth = param['depth']
     interleaved = param['interleaved']
+    mask = param['mask']
 
     pix = array('B', im.getdata())
 
@@ -114,10 +115,29 @@ def do_bitmap(im, desc):
                 'x'.join(map(str, [width, height, depth])),
                 'x'.join(map(str, [has_width, has_height, has_depth]))))
 
+    bpl = planar(pix, width, height, depth)
+
+    print_bitmap(name, bpl, width, height, depth, interleaved)
+
+    # Mask has all non-zero pixels set. When bitmap is interleaved, so is its
+    # mask and all of its bitplanes are the same. That makes it possible to
+    # blit all bitplanes of a masked interleaved bitmap at once.
+    if mask:
+        print('')
+        if interleaved:
+            pix = array('B', [(1 << depth) - 1 if p else 0 for p in pix])
+            print_bitmap(name + '_mask', planar(pix, width, height, depth),
+                         width, height, depth, True)
+        else:
+            pix = array('B', [int(p != 0) for p in pix])
+            print_bitmap(name + '_mask', planar(pix, width, height, 1),
+                         width, height, 1, False)
+
+
+def print_bitmap(name, bpl, width, height, depth, interleaved):
     bytesPerRow = ((width + 15) & ~15) // 8
     wordsPerRow = bytesPerRow // 2
     bplSize = bytesPerRow * height
-    bpl = planar(pix, width, height, depth)
 
     print('static __data_chip u_short _%s_bpl[] = {' % name)
     if interleaved:
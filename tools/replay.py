@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+
+import argparse
+import re
+import sys
+
+
+FRAME_RE = re.compile(r'\[Record\] T (-?\d+)')
+EVENT_RE = re.compile(r'\[Record\] E ([0-9a-f]{8}) ([0-9a-f]{8}) ([0-9a-f]{8})')
+
+
+REPLAY_STOP = [0x8000, 0x0000]
+REPLAY_END = [0xffff, 0xffff]
+
+
+# Each Render call is described by frame counter value and input events that
+# arrived since previous call. Events logged after the last frame are lost.
+# Frame counter is reset by EffectRun, so it going back starts a new session.
+def parse(lines):
+    sessions = []
+    frames = []
+    events = []
+
+    for line in lines:
+        m = EVENT_RE.search(line)
+        if m:
+            events.append([int(x, 16) for x in m.groups()])
+            continue
+
+        m = FRAME_RE.search(line)
+        if m:
+            frame = int(m.group(1))
+            if frames and frame < frames[-1][0]:
+                sessions.append(frames)
+                frames = []
+            frames.append((frame, events))
+            events = []
+
+    if frames:
+        sessions.append(frames)
+
+    return sessions
+
+
+def words(value):
+    return [(value >> 16) & 0xffff, value & 0xffff]
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Convert log recorded with RECORD=1 into replay data.')
+    parser.add_argument('log', metavar='LOG', type=str,
+                        help='Emulator output with [Record] lines.')
+    args = parser.parse_args()
+
+    with open(args.log, errors='replace') as f:
+        sessions = parse(f)
+
+    if not sessions:
+        raise SystemExit('No recorded frames found in "%s"!' % args.log)
+
+    print('/* Generated by replay.py from %s (%d sessions). */' %
+          (args.log, len(sessions)))
+    print('#include <types.h>')
+    print('')
+    print('u_short ReplayData[] = {')
+    for i, frames in enumerate(sessions):
+        for frame, events in frames:
+            data = words(frame) + [len(events)]
+            for event in events:
+                for value in event:
+                    data.extend(words(value))
+            print('  %s,' % ', '.join('0x%04x' % x for x in data))
+        last = i == len(sessions) - 1
+        print('  %s%s' % (', '.join('0x%04x' % x for x in
+                                    (REPLAY_END if last else REPLAY_STOP)),
+                          '' if last else ','))
+    print('};')
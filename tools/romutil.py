@@ -20,9 +20,13 @@ from fsutil import SECTOR, write_pad, Filesystem
 #
 # sector 2..: file system image
 #
+# If file system image does not fit into ROM, all files but the executable
+# get packed (see fsutil.py). Kernel inflates a packed file when it's opened.
+#
 
 ROMADDR = 0xf80000
 ROMSIZE = 0x080000
+FOOTER = 16
 
 
 def write_startup(rom, startup, exe):
@@ -37,6 +41,19 @@ def write_startup(rom, startup, exe):
     rom.write(startup.getvalue())
 
 
+def compress(path):
+    with open(path, 'rb') as fh:
+        archive = Filesystem.load(fh)
+    # Executable file is loaded by startup code, so it's kept uncompressed
+    for entry in archive:
+        if not entry.exe:
+            entry.pack()
+    archive.relocate()
+    image = BytesIO()
+    archive.write(image)
+    return image.getvalue()
+
+
 def write_footer(rom):
     rom.seek(-16, os.SEEK_END)
     rom.write(bytes.fromhex('471848194f1a531b541c4f1d571e4e1f'))
@@ -48,6 +65,9 @@ if __name__ == '__main__':
     parser.add_argument(
         'startup', metavar='STARTUP', type=str,
         help='ROM startup code')
+    parser.add_argument(
+        '-z', '--compress', action='store_true',
+        help='Pack files even if file system image would fit into ROM')
     parser.add_argument(
         'image', metavar='IMAGE', type=str,
         help='File system image file')
@@ -70,12 +90,24 @@ if __name__ == '__main__':
     if not executable:
         raise SystemExit('No AmigaHunk executable found!')
 
+    with open(args.image, 'rb') as img:
+        image = img.read()
+
+    if args.compress or 2 * SECTOR + len(image) > ROMSIZE - FOOTER:
+        size = len(image)
+        image = compress(args.image)
+        if 2 * SECTOR + len(image) > ROMSIZE - FOOTER:
+            raise SystemExit('Packed image does not fit into ROM!')
+        print('ROM file system image packed from %d to %d bytes' %
+              (size, len(image)))
+        # Executable file position may have changed
+        executable = next(entry for entry in Filesystem.load(BytesIO(image))
+                          if entry.exe)
+
     with open(args.rom, 'wb') as rom:
         write_startup(rom, startup, executable)
-
         # Write file system image
-        with open(args.image, 'rb') as img:
-            rom.write(img.read())
+        rom.write(image)
 
         # Complete ROM disk image
         write_pad(rom, ROMSIZE)